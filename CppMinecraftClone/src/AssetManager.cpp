@@ -0,0 +1,310 @@
+#include "headerfiles/AssetManager.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/Stats.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "includes/stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <sys/stat.h>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace {
+    // EXT/ARB_texture_filter_anisotropic, glad was generated without extensions
+    const GLenum TEXTURE_MAX_ANISOTROPY = 0x84FE;
+    const GLenum MAX_TEXTURE_MAX_ANISOTROPY = 0x84FF;
+
+    // Files are checked for changes this often
+    const std::chrono::milliseconds WATCH_INTERVAL(1000);
+
+    int64_t modifiedTime(const std::string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return 0;
+        return static_cast<int64_t>(info.st_mtime);
+    }
+
+    template <typename T>
+    bool isFinished(const std::future<T>& job) {
+        return job.valid() && job.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready;
+    }
+}
+
+TextureArrayAsset::~TextureArrayAsset() {
+    glDeleteTextures(1, &id);
+}
+
+AssetManager::~AssetManager() {
+    glDeleteBuffers(1, &uploadPBO);
+}
+
+std::shared_ptr<TextureArrayAsset> AssetManager::loadTextureArray(const std::string& path, int tileSize, int tilesPerRow) {
+    TextureEntry& entry = textures[path];
+    if (std::shared_ptr<TextureArrayAsset> existing = entry.asset.lock()) {
+        return existing;
+    }
+
+    std::shared_ptr<TextureArrayAsset> asset = std::make_shared<TextureArrayAsset>();
+    glGenTextures(1, &asset->id);
+
+    entry.path = path;
+    entry.tileSize = tileSize;
+    entry.tilesPerRow = tilesPerRow;
+    entry.asset = asset;
+    entry.modified = modifiedTime(path);
+    if (!entry.job.valid()) {
+        startTextureJob(entry);
+    }
+    return asset;
+}
+
+std::shared_ptr<ShaderAsset> AssetManager::loadShader(const std::string& vertexPath, const std::string& fragmentPath) {
+    ShaderEntry& entry = shaders[vertexPath + "|" + fragmentPath];
+    if (std::shared_ptr<ShaderAsset> existing = entry.asset.lock()) {
+        return existing;
+    }
+
+    std::shared_ptr<ShaderAsset> asset = std::make_shared<ShaderAsset>();
+
+    entry.vertexPath = vertexPath;
+    entry.fragmentPath = fragmentPath;
+    entry.asset = asset;
+    entry.vertexModified = modifiedTime(vertexPath);
+    entry.fragmentModified = modifiedTime(fragmentPath);
+    if (!entry.job.valid()) {
+        startShaderJob(entry);
+    }
+    return asset;
+}
+
+void AssetManager::startTextureJob(TextureEntry& entry) {
+    std::string path = entry.path;
+    int tileSize = entry.tileSize;
+    int tilesPerRow = entry.tilesPerRow;
+    entry.job = std::async(std::launch::async, [path, tileSize, tilesPerRow] {
+        return decodeTiles(path, tileSize, tilesPerRow);
+    });
+}
+
+void AssetManager::startShaderJob(ShaderEntry& entry) {
+    std::string vertexPath = entry.vertexPath;
+    std::string fragmentPath = entry.fragmentPath;
+    entry.job = std::async(std::launch::async, [vertexPath, fragmentPath] {
+        PROFILE_ZONE("AssetManager::readShader");
+
+        std::pair<bool, ShaderSource> result;
+        result.first = Shader::readSource(vertexPath, fragmentPath, result.second);
+        return result;
+    });
+}
+
+AssetManager::DecodedTiles AssetManager::decodeTiles(const std::string& path, int tileSize, int tilesPerRow) {
+    PROFILE_ZONE("AssetManager::decodeTiles");
+
+    DecodedTiles tiles;
+
+    int width, height, nrChannels;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 4);
+    if (!data) {
+        std::cout << "ERROR::ASSETS::TEXTURE_NOT_LOADED: " << path << std::endl;
+        return tiles;
+    }
+
+    // Copying tiles out of a smaller image would read past its pixels. The previous texture
+    // stays when a reload is rejected
+    if (width < tilesPerRow * tileSize || height < tileSize) {
+        std::cout << "ERROR::ASSETS::TEXTURE_TOO_SMALL: " << path << " is " << width << "x" << height << std::endl;
+        stbi_image_free(data);
+        return tiles;
+    }
+
+    // One layer per tile, in reading order. Rows past the last whole tile are ignored
+    tiles.valid = true;
+    tiles.tileSize = tileSize;
+    tiles.layers = tilesPerRow * (height / tileSize);
+    tiles.pixels.resize(static_cast<size_t>(tiles.layers) * tileSize * tileSize * 4);
+
+    for (int layer = 0; layer < tiles.layers; ++layer) {
+        int tileX = (layer % tilesPerRow) * tileSize;
+        int tileY = (layer / tilesPerRow) * tileSize;
+
+        for (int row = 0; row < tileSize; ++row) {
+            const unsigned char* source = data + ((tileY + row) * width + tileX) * 4;
+            std::memcpy(&tiles.pixels[((layer * tileSize) + row) * tileSize * 4], source, tileSize * 4);
+        }
+    }
+
+    stbi_image_free(data);
+    return tiles;
+}
+
+void AssetManager::uploadTiles(TextureArrayAsset& asset, const DecodedTiles& tiles) {
+    PROFILE_ZONE("AssetManager::uploadTiles");
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>(tiles.pixels.size());
+
+    // Writing into a mapped pixel buffer lets the driver copy to the texture asynchronously
+    if (uploadPBO == 0) {
+        glGenBuffers(1, &uploadPBO);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadPBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+    const void* pixels = nullptr;
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, tiles.pixels.data(), tiles.pixels.size());
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pixels = tiles.pixels.data();
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, asset.id);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, tiles.tileSize, tiles.tileSize, tiles.layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    // Mipmaps are built per layer, so minification never blends in a neighboring tile
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    if (glfwExtensionSupported("GL_EXT_texture_filter_anisotropic") || glfwExtensionSupported("GL_ARB_texture_filter_anisotropic")) {
+        float maxAnisotropy = 1.0f;
+        glGetFloatv(MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+        glTexParameterf(GL_TEXTURE_2D_ARRAY, TEXTURE_MAX_ANISOTROPY, std::min(maxAnisotropy, 8.0f));
+    }
+
+    Stats::bytesUploaded += size;
+    asset.ready = true;
+}
+
+void AssetManager::update() {
+    PROFILE_ZONE("AssetManager::update");
+
+    for (auto it = textures.begin(); it != textures.end();) {
+        TextureEntry& entry = it->second;
+
+        if (isFinished(entry.job)) {
+            DecodedTiles tiles = entry.job.get();
+            std::shared_ptr<TextureArrayAsset> asset = entry.asset.lock();
+            if (asset && tiles.valid) {
+                uploadTiles(*asset, tiles);
+            }
+        }
+
+        // Released by every user, a job still in flight is waited out first
+        if (entry.asset.expired() && !entry.job.valid()) {
+            it = textures.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Every finished program is created before any is waited on, so they compile side by side
+    std::vector<std::pair<std::shared_ptr<ShaderAsset>, std::unique_ptr<Shader>>> created;
+    for (auto it = shaders.begin(); it != shaders.end();) {
+        ShaderEntry& entry = it->second;
+
+        if (isFinished(entry.job)) {
+            std::pair<bool, ShaderSource> result = entry.job.get();
+            std::shared_ptr<ShaderAsset> asset = entry.asset.lock();
+            if (asset && result.first) {
+                created.emplace_back(asset, std::unique_ptr<Shader>(new Shader(result.second)));
+            }
+        }
+
+        if (entry.asset.expired() && !entry.job.valid()) {
+            it = shaders.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for (auto& program : created) {
+        ShaderAsset& asset = *program.first;
+
+        // A broken edit keeps the last working program, a broken first load leaves the asset
+        // not ready so startup stops
+        if (!program.second->isLinked()) {
+            if (asset.shader) {
+                std::cout << "ERROR::ASSETS::SHADER_RELOAD_FAILED: keeping the previous program" << std::endl;
+            }
+            else {
+                std::cout << "ERROR::ASSETS::SHADER_NOT_LINKED" << std::endl;
+            }
+            continue;
+        }
+
+        asset.shader = std::move(program.second);
+        if (asset.onLoad) {
+            asset.onLoad(*asset.shader);
+        }
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - lastWatchCheck >= WATCH_INTERVAL) {
+        lastWatchCheck = now;
+        checkForChanges();
+    }
+}
+
+void AssetManager::checkForChanges() {
+    PROFILE_ZONE("AssetManager::checkForChanges");
+
+    for (auto& texture : textures) {
+        TextureEntry& entry = texture.second;
+        if (entry.job.valid() || entry.asset.expired()) continue;
+
+        int64_t modified = modifiedTime(entry.path);
+        if (modified != entry.modified) {
+            entry.modified = modified;
+            std::cout << "Reloading " << entry.path << std::endl;
+            startTextureJob(entry);
+        }
+    }
+
+    for (auto& shader : shaders) {
+        ShaderEntry& entry = shader.second;
+        if (entry.job.valid() || entry.asset.expired()) continue;
+
+        int64_t vertexModified = modifiedTime(entry.vertexPath);
+        int64_t fragmentModified = modifiedTime(entry.fragmentPath);
+        if (vertexModified != entry.vertexModified || fragmentModified != entry.fragmentModified) {
+            entry.vertexModified = vertexModified;
+            entry.fragmentModified = fragmentModified;
+            std::cout << "Reloading " << entry.vertexPath << " and " << entry.fragmentPath << std::endl;
+            startShaderJob(entry);
+        }
+    }
+}
+
+bool AssetManager::isLoading() const {
+    for (const auto& texture : textures) {
+        if (texture.second.job.valid()) return true;
+    }
+    for (const auto& shader : shaders) {
+        if (shader.second.job.valid()) return true;
+    }
+    return false;
+}
+
+void AssetManager::finishLoading() {
+    PROFILE_ZONE("AssetManager::finishLoading");
+
+    while (isLoading()) {
+        update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,196 @@
+#include "headerfiles/Biomes.hpp"
+#include "headerfiles/Noise.hpp"
+#include "headerfiles/Profiler.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace Biomes {
+    namespace {
+        // Blocks between climate samples and blocks per side of a cached region
+        const int CLIMATE_STEP = 16;
+        const int REGION_SIZE = 256;
+        const int REGION_SAMPLES = REGION_SIZE / CLIMATE_STEP + 1;
+
+        // Regions kept at once, the least recently used one goes first
+        const size_t CACHE_CAPACITY = 256;
+
+        const float TEMPERATURE_FREQUENCY = 1.0f / 600.0f;
+        const float HUMIDITY_FREQUENCY = 1.0f / 450.0f;
+
+        // Distance in climate space over which one biome fades into the next
+        const float BLEND_WIDTH = 0.12f;
+
+        const Biome BIOMES[BIOME_COUNT] = {
+            { "Plains", 0.0f, 0.0f, 70.0f, 50.0f, UVHelper::BlockType::GRASS, UVHelper::BlockType::DIRT, 0.1f },
+            { "Forest", 0.1f, 0.3f, 78.0f, 80.0f, UVHelper::BlockType::GRASS, UVHelper::BlockType::DIRT, 0.8f },
+            { "Desert", 0.3f, -0.25f, 68.0f, 40.0f, UVHelper::BlockType::SAND, UVHelper::BlockType::SAND, 0.0f },
+            { "Mountains", -0.3f, -0.1f, 105.0f, 170.0f, UVHelper::BlockType::STONE, UVHelper::BlockType::STONE, 0.0f }
+        };
+
+        int floorDiv(int value, int divisor) {
+            return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+        }
+    }
+
+    struct ClimateRegion {
+        float temperature[REGION_SAMPLES][REGION_SAMPLES];
+        float humidity[REGION_SAMPLES][REGION_SAMPLES];
+    };
+
+    namespace {
+        struct RegionCache {
+            std::mutex mutex;
+            // Most recently used at the front
+            std::list<int64_t> order;
+            std::unordered_map<int64_t, std::pair<std::shared_ptr<const ClimateRegion>, std::list<int64_t>::iterator>> regions;
+        };
+
+        RegionCache cache;
+        std::atomic<int64_t> cacheHits(0);
+        std::atomic<int64_t> cacheMisses(0);
+
+        int64_t regionKey(int regionX, int regionZ) {
+            return (static_cast<int64_t>(regionX) << 32) | static_cast<uint32_t>(regionZ);
+        }
+
+        std::shared_ptr<const ClimateRegion> buildRegion(int regionX, int regionZ) {
+            PROFILE_ZONE("Biomes::buildRegion");
+
+            std::shared_ptr<ClimateRegion> region = std::make_shared<ClimateRegion>();
+            for (int i = 0; i < REGION_SAMPLES; ++i) {
+                for (int j = 0; j < REGION_SAMPLES; ++j) {
+                    float x = static_cast<float>(regionX * REGION_SIZE + i * CLIMATE_STEP);
+                    float z = static_cast<float>(regionZ * REGION_SIZE + j * CLIMATE_STEP);
+                    region->temperature[i][j] = Noise::perlin(Noise::TEMPERATURE, x * TEMPERATURE_FREQUENCY, 0.0f, z * TEMPERATURE_FREQUENCY);
+                    region->humidity[i][j] = Noise::perlin(Noise::HUMIDITY, x * HUMIDITY_FREQUENCY, 0.0f, z * HUMIDITY_FREQUENCY);
+                }
+            }
+            return region;
+        }
+
+        std::shared_ptr<const ClimateRegion> getRegion(int regionX, int regionZ) {
+            int64_t key = regionKey(regionX, regionZ);
+
+            {
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                auto found = cache.regions.find(key);
+                if (found != cache.regions.end()) {
+                    cache.order.splice(cache.order.begin(), cache.order, found->second.second);
+                    ++cacheHits;
+                    return found->second.first;
+                }
+            }
+
+            // Built outside the lock so other threads keep sampling. Two threads missing the
+            // same region both build it and the second one is dropped
+            ++cacheMisses;
+            std::shared_ptr<const ClimateRegion> region = buildRegion(regionX, regionZ);
+
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            auto found = cache.regions.find(key);
+            if (found != cache.regions.end()) {
+                return found->second.first;
+            }
+
+            cache.order.push_front(key);
+            cache.regions[key] = std::make_pair(region, cache.order.begin());
+
+            // Evicted regions stay alive for samplers still holding them
+            if (cache.regions.size() > CACHE_CAPACITY) {
+                cache.regions.erase(cache.order.back());
+                cache.order.pop_back();
+            }
+            return region;
+        }
+
+        float bilinear(const float (&samples)[REGION_SAMPLES][REGION_SAMPLES], int i, int j, float fx, float fz) {
+            float nearRow = samples[i][j] + (samples[i + 1][j] - samples[i][j]) * fx;
+            float farRow = samples[i][j + 1] + (samples[i + 1][j + 1] - samples[i][j + 1]) * fx;
+            return nearRow + (farRow - nearRow) * fz;
+        }
+
+        ColumnClimate blendBiomes(float temperature, float humidity) {
+            ColumnClimate climate = {};
+            float totalWeight = 0.0f;
+            for (int biome = 0; biome < BIOME_COUNT; ++biome) {
+                float dt = temperature - BIOMES[biome].temperature;
+                float dh = humidity - BIOMES[biome].humidity;
+                climate.weights[biome] = std::exp(-(dt * dt + dh * dh) / (BLEND_WIDTH * BLEND_WIDTH));
+                totalWeight += climate.weights[biome];
+            }
+
+            for (int biome = 0; biome < BIOME_COUNT; ++biome) {
+                // Far from every biome all weights underflow, plains takes over then
+                float weight = totalWeight > 0.0f ? climate.weights[biome] / totalWeight : (biome == PLAINS ? 1.0f : 0.0f);
+                climate.weights[biome] = weight;
+                climate.baseHeight += BIOMES[biome].baseHeight * weight;
+                climate.heightRange += BIOMES[biome].heightRange * weight;
+                climate.treeChance += BIOMES[biome].treeChance * weight;
+            }
+            return climate;
+        }
+    }
+
+    const Biome& getBiome(BiomeType type) {
+        return BIOMES[type];
+    }
+
+    ColumnClimate ClimateSampler::sample(int x, int z) {
+        int columnRegionX = floorDiv(x, REGION_SIZE);
+        int columnRegionZ = floorDiv(z, REGION_SIZE);
+        if (!region || columnRegionX != regionX || columnRegionZ != regionZ) {
+            region = getRegion(columnRegionX, columnRegionZ);
+            regionX = columnRegionX;
+            regionZ = columnRegionZ;
+        }
+
+        int localX = x - regionX * REGION_SIZE;
+        int localZ = z - regionZ * REGION_SIZE;
+        int i = localX / CLIMATE_STEP, j = localZ / CLIMATE_STEP;
+        float fx = static_cast<float>(localX - i * CLIMATE_STEP) / CLIMATE_STEP;
+        float fz = static_cast<float>(localZ - j * CLIMATE_STEP) / CLIMATE_STEP;
+
+        float temperature = bilinear(region->temperature, i, j, fx, fz);
+        float humidity = bilinear(region->humidity, i, j, fx, fz);
+        return blendBiomes(temperature, humidity);
+    }
+
+    ColumnClimate sampleUncached(int x, int z) {
+        float temperature = Noise::perlin(Noise::TEMPERATURE, x * TEMPERATURE_FREQUENCY, 0.0f, z * TEMPERATURE_FREQUENCY);
+        float humidity = Noise::perlin(Noise::HUMIDITY, x * HUMIDITY_FREQUENCY, 0.0f, z * HUMIDITY_FREQUENCY);
+        return blendBiomes(temperature, humidity);
+    }
+
+    BiomeType surfaceBiome(const ColumnClimate& climate, int x, int z) {
+        // Hash of the column in 0..1
+        uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(z) * 19349663u;
+        hash ^= hash >> 13;
+        hash *= 0x5bd1e995u;
+        hash ^= hash >> 15;
+        float threshold = (hash & 0xFFFF) / 65536.0f;
+
+        float cumulative = 0.0f;
+        for (int biome = 0; biome < BIOME_COUNT; ++biome) {
+            cumulative += climate.weights[biome];
+            if (threshold < cumulative) return static_cast<BiomeType>(biome);
+        }
+        return PLAINS;
+    }
+
+    int getCachedRegions() {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        return static_cast<int>(cache.regions.size());
+    }
+
+    int64_t getCacheHits() {
+        return cacheHits.load();
+    }
+
+    int64_t getCacheMisses() {
+        return cacheMisses.load();
+    }
+}
@@ -3,14 +3,25 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cmath>
 #include <iostream>
 
 #include "headerfiles/Chunk.hpp"
 #include "headerfiles/World.hpp"
+#include "headerfiles/Profiler.hpp"
 
+namespace {
+    constexpr float PLAYER_HALF_WIDTH = 0.2f;
+    constexpr float PLAYER_EYE_HEIGHT = 1.8f;
+    constexpr float PLAYER_HEAD_CLEARANCE = 0.1f;
+}
+
+// Starts above the world center, placeOnGround moves it down once the world exists
 Camera::Camera(GLFWwindow* window, Player& player) :
     cameraPos(glm::vec3(WORLD_SIZE_X / 2 * CHUNK_SIZE_X, 90.0f, WORLD_SIZE_Z / 2 * CHUNK_SIZE_Z)),
     //cameraPos(glm::vec3(1.0f, 90.0f, 1.0f)),
+    previousPos(cameraPos),
+    renderPos(cameraPos),
     cameraTarget(glm::vec3(0.0f, 0.0f, -1.0f)),
     cameraUp(glm::vec3(0.0f, 1.0f, 0.0f)),
     yaw(45.0f),
@@ -24,13 +35,14 @@ Camera::Camera(GLFWwindow* window, Player& player) :
     velocity(0.0f),
     curPlayer(player)
 {
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetScrollCallback(window, scroll_callback);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    glfwSetWindowUserPointer(window, this);
 }
 
-void Camera::processCameraInput(GLFWwindow* window, float& deltaTime, bool sprinting) {
+void Camera::processCameraInput(const InputFrame& input, float deltaTime, bool sprinting) {
+    PROFILE_ZONE("Camera::processCameraInput");
+
+    previousPos = cameraPos;
+
     const float camSpeed = (curPlayer.physicalState ? 4.0f : 15.0f) * deltaTime * (sprinting ? 1.25f : 1);
 
     glm::vec3 forward = glm::normalize(glm::vec3(cameraTarget.x, 0.0f, cameraTarget.z));
@@ -38,53 +50,34 @@ void Camera::processCameraInput(GLFWwindow* window, float& deltaTime, bool sprin
 
     glm::vec3 move(0.0f);
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) move += forward;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) move -= forward;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) move -= right;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) move += right;
+    if (input.isKeyDown(GLFW_KEY_W)) move += forward;
+    if (input.isKeyDown(GLFW_KEY_S)) move -= forward;
+    if (input.isKeyDown(GLFW_KEY_A)) move -= right;
+    if (input.isKeyDown(GLFW_KEY_D)) move += right;
 
     if (curPlayer.physicalState) {
-        float maxDistance = groundedCheck(velocity);
-
-
-        if (!isGrounded || velocity > 0.0f) {
-            velocity = std::max(velocity - (deltaTime / 3.0f), -0.5f);
-            if (velocity > 0.0f) headerCheck(velocity);
-
-            cameraPos.y += velocity;
-        }
-        else {
-            if (maxDistance <= -0.00001f) cameraPos.y += std::max(velocity, maxDistance);
-            else velocity = 0.0f;
-
-            if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-                velocity = 0.1f;
-        }
+        velocity = std::max(velocity - (deltaTime / 3.0f), -0.5f);
+        if (isGrounded && input.isKeyDown(GLFW_KEY_SPACE))
+            velocity = 0.1f;
 
         if (glm::dot(move, move) > 0.0f) {
             move = glm::normalize(move) * camSpeed;
+        }
+        move.y = velocity;
 
-            glm::vec3 tryMove = move;
-
-            if (move.x != 0.0f) {
-                glm::vec3 moveX{ move.x, 0.0f, 0.0f };
-                if (horizontalCollision(moveX)) tryMove.x = 0.0f;
-            }
-
-            if (move.z != 0.0f) {
-                glm::vec3 moveZ{ 0.0f, 0.0f, move.z };
-                if (horizontalCollision(moveZ)) tryMove.z = 0.0f;
-            }
+        Collision::SweepResult result = Collision::sweep(getPlayerBox(), move);
+        cameraPos += result.moved;
 
-            cameraPos += tryMove;
-        }
+        // Landing or bumping the head both stop vertical motion
+        isGrounded = result.contactNormal.y > 0;
+        if (result.contactNormal.y != 0) velocity = 0.0f;
     }
     else {
         velocity = 0.0f;
 
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        if (input.isKeyDown(GLFW_KEY_SPACE))
             cameraPos.y += camSpeed / 1.25f;
-        if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        if (input.isKeyDown(GLFW_KEY_LEFT_SHIFT))
             cameraPos.y -= camSpeed / 1.25f;
 
         if (glm::dot(move, move) > 0.0f) {
@@ -95,20 +88,24 @@ void Camera::processCameraInput(GLFWwindow* window, float& deltaTime, bool sprin
 }
 
 void Camera::setCamera(Shader& ourShader) {
-    glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraTarget, cameraUp);
+    glm::mat4 view = glm::lookAt(renderPos, renderPos + cameraTarget, cameraUp);
     ourShader.setMatrix("view", view);
 }
 
-void Camera::setProjection(Shader& ourShader) {
+void Camera::setProjection(Shader& ourShader, double nearPlane, double farPlane) {
     glm::mat4 projection = glm::perspective(glm::radians(fov),
         (double)SCR_WIDTH / (double)SCR_HEIGHT,
-        0.1,
-        1000.0);
+        nearPlane,
+        farPlane);
     ourShader.setMatrix("projection", projection);
 }
 
 glm::vec3 Camera::getCamPos() {
-    return cameraPos;
+    return renderPos;
+}
+
+void Camera::interpolate(float alpha) {
+    renderPos = glm::mix(previousPos, cameraPos, alpha);
 }
 
 glm::vec3 Camera::getCamTarget() {
@@ -143,109 +140,16 @@ void Camera::updateFOV(bool isSprinting, float deltaTime) {
     fov = glm::clamp(fov, minFov, maxFov);
 }
 
-bool Camera::horizontalCollision(glm::vec3 move) {
-    const float playerWidth{ 0.2f };
-
-    for (int dx = -1; dx <= 1; dx += 2) {
-        for (int dz = -1; dz <= 1; dz += 2) {
-            glm::vec3 offset = glm::vec3(playerWidth * dx, 0.0f, playerWidth * dz);
-            glm::vec3 newPos = cameraPos + move + offset;
-
-            int chunkX = round(newPos.x) / CHUNK_SIZE_X;
-            int chunkZ = round(newPos.z) / CHUNK_SIZE_Z;
-            if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) continue;
-
-            Chunk& chunk = chunks[chunkX][chunkZ];
-            for (float yOffset : { -1.79f, -0.5f }) {
-                glm::ivec3 localPos = glm::ivec3(round(newPos.x), round(cameraPos.y + yOffset), round(newPos.z))
-                    - glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
-
-                if (chunk.getBlock(localPos.x, localPos.y, localPos.z) != UVHelper::BlockType::AIR) return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-float Camera::groundedCheck(float currentVelocity) {
-    isGrounded = false;
-    float maxDistance = 0.0f;
-
-    const float playerWidth = 0.2f;
-    const float playerFeet = cameraPos.y - 1.8f + currentVelocity;
-
-    for (int x = 0; x < 2; x++) {
-        for (int z = 0; z < 2; z++) {
-            glm::ivec3 newPos(round(cameraPos.x + playerWidth * (x == 0 ? -1 : 1)), round(playerFeet), round(cameraPos.z + playerWidth * (z == 0 ? -1 : 1)));
-
-            int chunkX = newPos.x / CHUNK_SIZE_X;
-            int chunkZ = newPos.z / CHUNK_SIZE_Z;
-            if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) return 0.0f;
-
-            Chunk& chunk = chunks[chunkX][chunkZ];
-            glm::ivec3 localPos = newPos - glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
-
-            if (chunk.getBlock(localPos.x, localPos.y, localPos.z) != UVHelper::BlockType::AIR) {
-                isGrounded = true;
-                goto end;
-            }
-        }
-    }
-
-end:
-    if (isGrounded) {
-        float blockTop = round(playerFeet) + 1.0f;
-        maxDistance = blockTop - playerFeet;
-    }
-
-    return maxDistance;
-}
-
-void Camera::headerCheck(float& currentVelocity) {
-    const float playerWidth = 0.2f;
-    const float playerHead = cameraPos.y + 0.1f + currentVelocity;
-
-    for (int x = 0; x < 2; x++) {
-        for (int z = 0; z < 2; z++) {
-            glm::ivec3 newPos(round(cameraPos.x + playerWidth * (x == 0 ? -1 : 1)), round(playerHead), round(cameraPos.z + playerWidth * (z == 0 ? -1 : 1)));
-
-            int chunkX = newPos.x / CHUNK_SIZE_X;
-            int chunkZ = newPos.z / CHUNK_SIZE_Z;
-            if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) return;
-
-            Chunk& chunk = chunks[chunkX][chunkZ];
-            glm::ivec3 localPos = newPos - glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
-
-            if (chunk.getBlock(localPos.x, localPos.y, localPos.z) != UVHelper::BlockType::AIR) {
-                velocity = 0.0f;
-                return;
-            }
-        }
-    }
+Collision::AABB Camera::getPlayerBox() const {
+    // The camera sits at eye height, 1.8 above the feet and just under the top of the head
+    return {
+        cameraPos - glm::vec3(PLAYER_HALF_WIDTH, PLAYER_EYE_HEIGHT, PLAYER_HALF_WIDTH),
+        cameraPos + glm::vec3(PLAYER_HALF_WIDTH, PLAYER_HEAD_CLEARANCE, PLAYER_HALF_WIDTH)
+    };
 }
 
 bool Camera::blockPlaceCheck(glm::ivec3 blockPlacePos) {
-    const float playerWidth = 0.2f;
-
-    for (int x = 0; x < 2; x++) {
-        for (int z = 0; z < 2; z++) {
-            if (!(round(cameraPos.x + playerWidth * (x == 0 ? -1 : 1)) == blockPlacePos.x && round(cameraPos.z + playerWidth * (z == 0 ? -1 : 1)) == blockPlacePos.z)) continue;
-            if (round(cameraPos.y) == blockPlacePos.y || round(cameraPos.y - 1.0f) == blockPlacePos.y) return false;
-        }
-    }
-
-    return true;
-}
-
-void Camera::mouse_callback(GLFWwindow* window, double xpos, double ypos) {
-    Camera* cam = static_cast<Camera*>(glfwGetWindowUserPointer(window));
-    if (cam) cam->processMouse(xpos, ypos);
-}
-
-void Camera::scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
-    Camera* cam = static_cast<Camera*>(glfwGetWindowUserPointer(window));
-    if (cam) cam->processScroll(yoffset);
+    return !Collision::overlaps(getPlayerBox(), Collision::blockBox(blockPlacePos));
 }
 
 void Camera::processMouse(double xpos, double ypos) {
@@ -270,6 +174,26 @@ void Camera::processMouse(double xpos, double ypos) {
 
     pitch = glm::clamp(pitch, -89.0, 89.0);
 
+    updateTarget();
+}
+
+void Camera::setPose(const glm::vec3& position, double newYaw, double newPitch) {
+    cameraPos = position;
+    previousPos = position;
+    renderPos = position;
+    yaw = newYaw;
+    pitch = glm::clamp(newPitch, -89.0, 89.0);
+    velocity = 0.0f;
+
+    updateTarget();
+}
+
+void Camera::placeOnGround() {
+    int groundHeight = getWorldHeightAt(cameraPos.x, cameraPos.z, Heightmap::MOTION_BLOCKING);
+    setPose(glm::vec3(cameraPos.x, groundHeight + PLAYER_EYE_HEIGHT, cameraPos.z), yaw, pitch);
+}
+
+void Camera::updateTarget() {
     glm::dvec3 direction = {
         cos(glm::radians(yaw)) * cos(glm::radians(pitch)),
         sin(glm::radians(pitch)),
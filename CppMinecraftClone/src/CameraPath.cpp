@@ -0,0 +1,76 @@
+#include "headerfiles/CameraPath.hpp"
+#include "headerfiles/Constants.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool CameraPath::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "ERROR::CAMERA_PATH::COULD_NOT_OPEN_FILE: " << path << std::endl;
+        return false;
+    }
+
+    keyframes.clear();
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream values(line);
+        Keyframe keyframe;
+        if (!(values >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.yaw >> keyframe.pitch)) {
+            std::cout << "ERROR::CAMERA_PATH::BAD_KEYFRAME: " << line << std::endl;
+            return false;
+        }
+        keyframes.push_back(keyframe);
+    }
+
+    if (keyframes.empty()) {
+        std::cout << "ERROR::CAMERA_PATH::NO_KEYFRAMES: " << path << std::endl;
+        return false;
+    }
+
+    std::stable_sort(keyframes.begin(), keyframes.end(), [](const Keyframe& a, const Keyframe& b) {
+        return a.time < b.time;
+    });
+    return true;
+}
+
+CameraPath CameraPath::flyover() {
+    const float worldX = static_cast<float>(WORLD_SIZE_X * CHUNK_SIZE_X);
+    const float worldZ = static_cast<float>(WORLD_SIZE_Z * CHUNK_SIZE_Z);
+
+    CameraPath path;
+    path.keyframes = {
+        { 0.0f,  glm::vec3(worldX * 0.1f, 110.0f, worldZ * 0.5f), 0.0, -15.0 },
+        { 5.0f,  glm::vec3(worldX * 0.5f, 100.0f, worldZ * 0.5f), 45.0, -20.0 },
+        { 10.0f, glm::vec3(worldX * 0.9f, 110.0f, worldZ * 0.5f), 180.0, -10.0 },
+    };
+    return path;
+}
+
+float CameraPath::duration() const {
+    return keyframes.empty() ? 0.0f : keyframes.back().time;
+}
+
+CameraPath::Keyframe CameraPath::sample(float time) const {
+    if (time <= keyframes.front().time) return keyframes.front();
+    if (time >= keyframes.back().time) return keyframes.back();
+
+    size_t next = 1;
+    while (keyframes[next].time < time) ++next;
+
+    const Keyframe& a = keyframes[next - 1];
+    const Keyframe& b = keyframes[next];
+    float t = (b.time > a.time) ? (time - a.time) / (b.time - a.time) : 1.0f;
+
+    Keyframe result;
+    result.time = time;
+    result.position = glm::mix(a.position, b.position, t);
+    result.yaw = a.yaw + (b.yaw - a.yaw) * t;
+    result.pitch = a.pitch + (b.pitch - a.pitch) * t;
+    return result;
+}
@@ -1,9 +1,8 @@
 #include "headerfiles/Chunk.hpp"
 
-#define STB_PERLIN_IMPLEMENTATION
-#include "includes/stb_perlin.h"
-
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include <glad/glad.h>
 #include <iostream>
@@ -11,7 +10,88 @@
 #include <glm/glm.hpp>
 
 #include "headerfiles/World.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/Stats.hpp"
+#include "headerfiles/TerrainGenerator.hpp"
+
+
+namespace {
+    // Frames a chunk has to go without edits or meshing before it is compressed
+    const int COMPRESS_AFTER_FRAMES = 300;
+    // Run lookups in one frame past which decoding the chunk is cheaper than searching runs.
+    // Neighbor mesh jobs read a chunk's border, up to four of them stay well below this
+    const int DECOMPRESS_READS_PER_FRAME = 65536;
+
+    // Swaps a mesh's previous upload for the new one in the stats totals. The CPU copy goes back
+    // to the arena pool after upload, MeshArenas counts that memory
+    void trackMeshUpload(int64_t& uploadedVertices, int64_t& uploadedIndices, size_t vertexFloats, size_t indexCount) {
+        int64_t vertices = static_cast<int64_t>(vertexFloats / TERRAIN_VERTEX_FLOATS);
+        int64_t indices = static_cast<int64_t>(indexCount);
+        int64_t bytes = vertices * TERRAIN_VERTEX_FLOATS * sizeof(float) + indices * sizeof(unsigned int);
+        int64_t oldBytes = uploadedVertices * TERRAIN_VERTEX_FLOATS * sizeof(float) + uploadedIndices * sizeof(unsigned int);
+
+        Stats::gpuVertices += vertices - uploadedVertices;
+        Stats::gpuIndices += indices - uploadedIndices;
+        Stats::meshGpuBytes += bytes - oldBytes;
+        Stats::bytesUploaded += bytes;
+
+        uploadedVertices = vertices;
+        uploadedIndices = indices;
+    }
+
+    // Appends one cube face centered on center with the given edge length. Grows the buffers
+    // once per face and writes in place, arenas from the pool already have the capacity
+    void appendFace(std::vector<float>& vertices, std::vector<unsigned int>& indices, unsigned int& indexCount,
+        int face, glm::vec3 center, float size, UVHelper::BlockType type) {
+        float layer = static_cast<float>(UVHelper::getTileLayer(type, face));
+
+        size_t vertexStart = vertices.size();
+        size_t indexStart = indices.size();
+        vertices.resize(vertexStart + 6 * TERRAIN_VERTEX_FLOATS);
+        indices.resize(indexStart + 6);
+
+        float* out = &vertices[vertexStart];
+        for (int vertex = 0; vertex < 6; ++vertex) {
+            int base = vertex * 6;
+
+            *out++ = vertexData[face][base + 0] * size + center.x;
+            *out++ = vertexData[face][base + 1] * size + center.y;
+            *out++ = vertexData[face][base + 2] * size + center.z;
+
+            // Normal
+            *out++ = vertexData[face][base + 3];
+            *out++ = vertexData[face][base + 4];
+            *out++ = vertexData[face][base + 5];
+
+            // Texture array layer
+            *out++ = layer;
+
+            indices[indexStart + vertex] = indexCount++;
+        }
+    }
+}
+
+void setupMeshBuffers(unsigned int& VAO, unsigned int& VBO, unsigned int& EBO) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, TERRAIN_VERTEX_FLOATS * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, TERRAIN_VERTEX_FLOATS * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, TERRAIN_VERTEX_FLOATS * sizeof(float), (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+}
 
+Chunk::Chunk() :
+    ChunkData(new DenseBlocks())
+{
+}
 
 Chunk::~Chunk() {
     glDeleteVertexArrays(1, &solidVAO);
@@ -21,18 +101,64 @@ Chunk::~Chunk() {
     glDeleteVertexArrays(1, &transparentVAO);
     glDeleteBuffers(1, &transparentVBO);
     glDeleteBuffers(1, &transparentEBO);
+
+    for (LodMesh& lod : lodMeshes) {
+        glDeleteVertexArrays(1, &lod.VAO);
+        glDeleteBuffers(1, &lod.VBO);
+        glDeleteBuffers(1, &lod.EBO);
+
+        trackMeshUpload(lod.uploadedVertices, lod.uploadedIndices, 0, 0);
+    }
+    trackMeshUpload(solidUploadedVertices, solidUploadedIndices, 0, 0);
+    trackMeshUpload(transparentUploadedVertices, transparentUploadedIndices, 0, 0);
 }
 
 void Chunk::regenMesh() {
-    if (!meshFuture.valid()) {
-        meshFuture = std::async(std::launch::async, [this] { this->generateMesh(); });
+    launchMeshJob(lodLevel);
+}
+
+void Chunk::launchMeshJob(int level) {
+    ensureDense();
+
+    if (level == 0) {
+        if (!meshFuture.valid()) {
+            meshingGeneration = editGeneration;
+            ++Stats::meshJobsInFlight;
+            meshFuture = std::async(std::launch::async, [this] {
+                this->generateMesh();
+                --Stats::meshJobsInFlight;
+            });
+        }
+        return;
     }
+
+    LodMesh& lod = lodMeshes[level - 1];
+    if (!lod.future.valid()) {
+        lod.meshingGeneration = editGeneration;
+        ++Stats::meshJobsInFlight;
+        lod.future = std::async(std::launch::async, [this, level] {
+            this->generateLodMesh(level);
+            --Stats::meshJobsInFlight;
+        });
+    }
+}
+
+void Chunk::markDirty() {
+    ++editGeneration;
+}
+
+bool Chunk::isMeshing() const {
+    return meshFuture.valid();
 }
 
 void Chunk::Add(int x, int y, int z, UVHelper::BlockType blockType, bool regenerateMesh) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z)
         return;
-    ChunkData[x][y][z] = blockType;
+    ensureDense();
+    ChunkData->blocks(x, y, z) = blockType;
+    updateHeightmaps(x, y, z, blockType);
+    modified = true;
+    markDirty();
 
     if (regenerateMesh) {
         regenMesh();
@@ -46,56 +172,217 @@ void Chunk::removeBlock(int x, int y, int z) {
 UVHelper::BlockType Chunk::getBlock(int x, int y, int z) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z)
         return UVHelper::BlockType::AIR;
-    return ChunkData[x][y][z];
+
+    if (const ColumnRuns* runs = activeColumns.load(std::memory_order_acquire)) {
+        compressedReads.fetch_add(1, std::memory_order_relaxed);
+        return runs->getBlock(x, y, z);
+    }
+    return ChunkData->blocks(x, y, z);
 }
 
-float Chunk::fbm(float x, float z) {
-    float total = 0.0f;
-    float frequency = 0.01f; 
-    float amplitude = 1.0f;
-    float persistence = 0.5f;    
-    float lacunarity = 2.0f; 
-    int octaves = 6;
-    float maxAmplitude = 0.0f;
+int Chunk::getHeight(int x, int z, Heightmap::Type type) const {
+    if (x < 0 || x >= CHUNK_SIZE_X || z < 0 || z >= CHUNK_SIZE_Z)
+        return 0;
+    return heightmaps[type][x][z];
+}
 
-    for (int i = 0; i < octaves; i++) {
-        total += stb_perlin_noise3(x * frequency, 0, z * frequency, 0, 0, 0) * amplitude;
-        maxAmplitude += amplitude;
-        amplitude *= persistence;
-        frequency *= lacunarity;
+void Chunk::rebuildHeightmaps() {
+    for (int type = 0; type < Heightmap::TYPE_COUNT; ++type) {
+        for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+            for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                int y = CHUNK_SIZE_Y - 1;
+                while (y >= 0 && !Heightmap::counts(static_cast<Heightmap::Type>(type), ChunkData->blocks(x, y, z))) --y;
+                heightmaps[type][x][z] = static_cast<uint8_t>(y + 1);
+            }
+        }
     }
+}
 
-    total /= maxAmplitude; 
-    return total;
+void Chunk::updateHeightmaps(int x, int y, int z, UVHelper::BlockType blockType) {
+    for (int type = 0; type < Heightmap::TYPE_COUNT; ++type) {
+        Heightmap::Type heightmap = static_cast<Heightmap::Type>(type);
+        uint8_t& height = heightmaps[type][x][z];
+
+        if (Heightmap::counts(heightmap, blockType)) {
+            if (y + 1 > height) height = static_cast<uint8_t>(y + 1);
+            continue;
+        }
+
+        // Only losing the top block moves the height, and then only down to the next block that counts
+        if (y + 1 != height) continue;
+        int top = y;
+        while (top > 0 && !Heightmap::counts(heightmap, ChunkData->blocks(x, top - 1, z))) --top;
+        height = static_cast<uint8_t>(top);
+    }
+}
+
+void Chunk::fillRow(int x, int y, int zStart, int count, UVHelper::BlockType blockType) {
+    ensureDense();
+    ChunkBlocks& blocks = ChunkData->blocks;
+    if (ChunkBlocks::LayoutType::CONTIGUOUS_ROWS) {
+        std::memset(&blocks(x, y, zStart), blockType, count);
+    }
+    else {
+        for (int i = 0; i < count; ++i) {
+            blocks(x, y, zStart + i) = blockType;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        updateHeightmaps(x, y, zStart + i, blockType);
+    }
+    modified = true;
 }
 
+int Chunk::replaceRow(int x, int y, int zStart, int count, UVHelper::BlockType from, UVHelper::BlockType to) {
+    ensureDense();
+    ChunkBlocks& blocks = ChunkData->blocks;
+    int replaced = 0;
+
+    for (int i = 0; i < count; ++i) {
+        UVHelper::BlockType& block = blocks(x, y, zStart + i);
+        if (block == from) {
+            block = to;
+            updateHeightmaps(x, y, zStart + i, to);
+            ++replaced;
+        }
+    }
+    if (replaced > 0) modified = true;
+    return replaced;
+}
+
+void Chunk::readRow(int x, int y, int zStart, int count, UVHelper::BlockType* out) const {
+    if (const ColumnRuns* runs = activeColumns.load(std::memory_order_acquire)) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = runs->getBlock(x, y, zStart + i);
+        }
+        return;
+    }
+    if (ChunkBlocks::LayoutType::CONTIGUOUS_ROWS) {
+        std::memcpy(out, &ChunkData->blocks(x, y, zStart), count);
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        out[i] = ChunkData->blocks(x, y, zStart + i);
+    }
+}
+
+void Chunk::writeRow(int x, int y, int zStart, int count, const UVHelper::BlockType* in, bool skipAir) {
+    ensureDense();
+    modified = true;
+
+    ChunkBlocks& blocks = ChunkData->blocks;
+    for (int i = 0; i < count; ++i) {
+        if (skipAir && in[i] == UVHelper::BlockType::AIR) continue;
+
+        blocks(x, y, zStart + i) = in[i];
+        updateHeightmaps(x, y, zStart + i, in[i]);
+    }
+}
 
 void Chunk::generateChunk() {
-    for (int x = 0; x < CHUNK_SIZE_X; ++x) {
-        for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
-            float xPos = (x + chunkNumberX * CHUNK_SIZE_X);
-            float zPos = (z + chunkNumberZ * CHUNK_SIZE_Z);
+    PROFILE_ZONE("Chunk::generateChunk");
 
-            float noiseValue = fbm(xPos, zPos);
-            noiseValue = (noiseValue + 1.0f) / 2.0f;
+    ensureDense();
+    TerrainGenerator::generate(chunkNumberX, chunkNumberZ, ChunkData->blocks, pendingWrites);
+    rebuildHeightmaps();
+    markDirty();
 
-            int minHeight = CHUNK_SIZE_Y / 8;
-            int maxHeight = CHUNK_SIZE_Y / 2;
+    ++Stats::chunksLoaded;
+    Stats::voxelBytes += sizeof(DenseBlocks);
+}
 
-            int height = minHeight + static_cast<int>(noiseValue * (maxHeight - minHeight));
+void Chunk::readColumns(ColumnRuns& out) const {
+    if (const ColumnRuns* runs = activeColumns.load(std::memory_order_acquire)) {
+        out = *runs;
+        return;
+    }
+    out.encode(ChunkData->blocks);
+}
 
-            for (int y = 0; y < height; ++y) {
-                if (y == height - 1) {
-                    Add(x, y, z, UVHelper::BlockType::GRASS);
-                }
-                else if (y > height - 5) {
-                    Add(x, y, z, UVHelper::BlockType::DIRT);
-                }
-                else {
-                    Add(x, y, z, UVHelper::BlockType::STONE);
-                }
-            }
+void Chunk::writeColumns(const ColumnRuns& in) {
+    ensureDense();
+    in.decode(ChunkData->blocks);
+    rebuildHeightmaps();
+    modified = true;
+}
+
+bool Chunk::isCompressed() const {
+    return activeColumns.load(std::memory_order_relaxed) != nullptr;
+}
+
+bool Chunk::hasJobsInFlight() const {
+    if (meshFuture.valid()) return true;
+    for (const LodMesh& lod : lodMeshes) {
+        if (lod.future.valid()) return true;
+    }
+    return false;
+}
+
+void Chunk::ensureDense() {
+    framesSinceDenseUse = 0;
+    if (!isCompressed()) return;
+
+    PROFILE_ZONE("Chunk::decompress");
+
+    ChunkData.reset(new DenseBlocks());
+    columns->decode(ChunkData->blocks);
+    activeColumns.store(nullptr, std::memory_order_release);
+
+    Stats::voxelBytes += sizeof(DenseBlocks);
+    --Stats::chunksCompressed;
+    retiredColumns = std::move(columns);
+}
+
+void Chunk::updateStorage() {
+    // Neighbor mesh jobs read this chunk's blocks as well
+    bool jobsNearby = hasJobsInFlight();
+    if (chunkNumberX > 0) jobsNearby = jobsNearby || chunks[chunkNumberX - 1][chunkNumberZ].hasJobsInFlight();
+    if (chunkNumberX + 1 < WORLD_SIZE_X) jobsNearby = jobsNearby || chunks[chunkNumberX + 1][chunkNumberZ].hasJobsInFlight();
+    if (chunkNumberZ > 0) jobsNearby = jobsNearby || chunks[chunkNumberX][chunkNumberZ - 1].hasJobsInFlight();
+    if (chunkNumberZ + 1 < WORLD_SIZE_Z) jobsNearby = jobsNearby || chunks[chunkNumberX][chunkNumberZ + 1].hasJobsInFlight();
+
+    if (retiredColumns && !jobsNearby) {
+        Stats::voxelBytes -= retiredColumns->getByteSize();
+        retiredColumns.reset();
+    }
+
+    if (isCompressed()) {
+        if (compressedReads.exchange(0, std::memory_order_relaxed) > DECOMPRESS_READS_PER_FRAME) {
+            ensureDense();
         }
+        return;
+    }
+
+    if (++framesSinceDenseUse < COMPRESS_AFTER_FRAMES || jobsNearby || retiredColumns) return;
+
+    PROFILE_ZONE("Chunk::compress");
+
+    columns.reset(new ColumnRuns());
+    columns->encode(ChunkData->blocks);
+    Stats::voxelBytes += columns->getByteSize();
+
+    activeColumns.store(columns.get(), std::memory_order_release);
+    compressedReads.store(0, std::memory_order_relaxed);
+    ++Stats::chunksCompressed;
+
+    // No job can be reading the dense blocks now
+    ChunkData.reset();
+    Stats::voxelBytes -= sizeof(DenseBlocks);
+}
+
+const std::vector<TerrainGenerator::StructureWrite>& Chunk::getPendingWrites(int offsetX, int offsetZ) const {
+    return pendingWrites.neighbors[offsetX + 1][offsetZ + 1];
+}
+
+void Chunk::clearPendingWrites() {
+    pendingWrites = TerrainGenerator::PendingWrites();
+}
+
+void Chunk::applyStructureWrites(const std::vector<TerrainGenerator::StructureWrite>& writes) {
+    ensureDense();
+    if (TerrainGenerator::applyWrites(ChunkData->blocks, writes) > 0) {
+        rebuildHeightmaps();
+        markDirty();
     }
 }
 
@@ -119,11 +406,16 @@ bool Chunk::isTransparent(UVHelper::BlockType blockType) const {
 }
 
 void Chunk::generateMesh() {
-    std::vector<float> newSolidVertices;
-    std::vector<unsigned int> newSolidIndices;
+    PROFILE_ZONE("Chunk::generateMesh");
+
+    // A remesh is usually close to the size of the previous mesh, a fresh arena reserves that
+    // so it doesn't grow step by step
+    std::unique_ptr<MeshArena> arena = MeshArenas::acquire();
+    arena->reserveFaces(static_cast<size_t>(solidUploadedIndices / 6), static_cast<size_t>(transparentUploadedIndices / 6));
 
-    std::vector<float> newTransparentVertices;
-    std::vector<unsigned int> newTransparentIndices;
+    // Shared with the sorter past upload, so these can't live in the arena
+    std::vector<glm::vec3> newTransparentFaceCenters;
+    newTransparentFaceCenters.reserve(static_cast<size_t>(transparentUploadedIndices / 6));
 
     unsigned int solidIndexCount = 0;
     unsigned int transparentIndexCount = 0;
@@ -180,140 +472,46 @@ void Chunk::generateMesh() {
                     }
 
                     if (shouldRenderFace) {
-                        UVHelper::BlockUV uvSet = UVHelper::blockTextures[type];
-                        int tileIndex = 0;
-
-                        if (face == 5) {
-                            tileIndex = uvSet.top;
-                        }
-                        else if (face == 4) {
-                            tileIndex = uvSet.bottom;
-                        }
-                        else {
-                            tileIndex = uvSet.side;
-                        }
-                        UVHelper::UVCoords uv = UVHelper::getUVCoords(tileIndex, 3, 16, 48);
-
-                        glm::vec2 uvCoords[6];
-
-                        switch (face) {
-                        case 0: // left
-                            uvCoords[0] = { uv.uMin, uv.vMax };
-                            uvCoords[1] = { uv.uMax, uv.vMin };
-                            uvCoords[2] = { uv.uMax, uv.vMax };
-
-                            uvCoords[3] = { uv.uMax, uv.vMin };
-                            uvCoords[4] = { uv.uMin, uv.vMax };
-                            uvCoords[5] = { uv.uMin, uv.vMin };
-                            break;
-                        case 1: // right
-                            uvCoords[0] = { uv.uMin, uv.vMax };
-                            uvCoords[1] = { uv.uMax, uv.vMax };
-                            uvCoords[2] = { uv.uMax, uv.vMin };
-
-                            uvCoords[3] = { uv.uMax, uv.vMin };
-                            uvCoords[4] = { uv.uMin, uv.vMin };
-                            uvCoords[5] = { uv.uMin, uv.vMax };
-                            break;
-                        case 2: // front
-                            uvCoords[0] = { uv.uMin, uv.vMin };
-                            uvCoords[1] = { uv.uMax, uv.vMin };
-                            uvCoords[2] = { uv.uMax, uv.vMax };
-                            uvCoords[3] = { uv.uMax, uv.vMax };
-                            uvCoords[4] = { uv.uMin, uv.vMax };
-                            uvCoords[5] = { uv.uMin, uv.vMin };
-                            break;
-                        case 3: // back
-                            uvCoords[0] = { uv.uMin, uv.vMin };
-                            uvCoords[1] = { uv.uMax, uv.vMax };
-                            uvCoords[2] = { uv.uMax, uv.vMin };
-
-                            uvCoords[3] = { uv.uMax, uv.vMax };
-                            uvCoords[4] = { uv.uMin, uv.vMin };
-                            uvCoords[5] = { uv.uMin, uv.vMax };
-                            break;
-                        case 4: // bottom 
-                            uvCoords[0] = { uv.uMin, uv.vMax };
-                            uvCoords[1] = { uv.uMax, uv.vMax };
-                            uvCoords[2] = { uv.uMax, uv.vMin };
-
-                            uvCoords[3] = { uv.uMax, uv.vMin };
-                            uvCoords[4] = { uv.uMin, uv.vMin };
-                            uvCoords[5] = { uv.uMin, uv.vMax };
-                            break;
-                        case 5: // top
-                            uvCoords[0] = { uv.uMin, uv.vMin };
-                            uvCoords[1] = { uv.uMax, uv.vMax };
-                            uvCoords[2] = { uv.uMax, uv.vMin };
-
-                            uvCoords[3] = { uv.uMax, uv.vMax };
-                            uvCoords[4] = { uv.uMin, uv.vMin };
-                            uvCoords[5] = { uv.uMin, uv.vMax };
-                            break;
-                        }
-
                         std::vector<float>* newVertices; 
                         std::vector<unsigned int>* newIndices;
                         unsigned int* indexCount;
                         if (isTransparent(type)) {
-                            newVertices = &newTransparentVertices;
-                            newIndices = &newTransparentIndices;
+                            newVertices = &arena->transparentVertices;
+                            newIndices = &arena->transparentIndices;
                             indexCount = &transparentIndexCount;
+
+                            newTransparentFaceCenters.push_back(glm::vec3(x, y, z) + 0.5f * glm::vec3(nx - x, ny - y, nz - z));
                         }
                         else {
-                            newVertices = &newSolidVertices;
-                            newIndices = &newSolidIndices;
+                            newVertices = &arena->solidVertices;
+                            newIndices = &arena->solidIndices;
                             indexCount = &solidIndexCount;
                         }
 
-                        for (int vertex = 0; vertex < 6; ++vertex) {
-                            int base = vertex * 6;
-
-                            newVertices->push_back(vertexData[face][base + 0] + x);
-                            newVertices->push_back(vertexData[face][base + 1] + y);
-                            newVertices->push_back(vertexData[face][base + 2] + z);
-
-                            // Normal
-                            newVertices->push_back(vertexData[face][base + 3]);
-                            newVertices->push_back(vertexData[face][base + 4]);
-                            newVertices->push_back(vertexData[face][base + 5]);
-
-                            // UV from atlas
-                            newVertices->push_back(uvCoords[vertex].x);
-                            newVertices->push_back(uvCoords[vertex].y);
-
-                            newIndices->push_back((*indexCount)++);
-                        }
+                        appendFace(*newVertices, *newIndices, *indexCount, face, glm::vec3(x, y, z), 1.0f, type);
                     }
                 }
             }
         }
     }
 
-    solidVertices = std::move(newSolidVertices);
-    solidIndices = std::move(newSolidIndices);
-
-    transparentVertices = std::move(newTransparentVertices);
-    transparentIndices = std::move(newTransparentIndices);
+    // A mesh that was never uploaded, only happens when meshing is driven without rendering
+    MeshArenas::release(std::move(meshArena));
+    meshArena = std::move(arena);
+    transparentFaceCenters = std::move(newTransparentFaceCenters);
 }
 
 void Chunk::buildMesh() {
-    // Solid
-    if (solidVAO == 0) {
-        glGenVertexArrays(1, &solidVAO);
-        glGenBuffers(1, &solidVBO);
-        glGenBuffers(1, &solidEBO);
+    PROFILE_ZONE("Chunk::buildMesh");
 
-        glBindVertexArray(solidVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, solidVBO);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, solidEBO);
+    const std::vector<float>& solidVertices = meshArena->solidVertices;
+    const std::vector<unsigned int>& solidIndices = meshArena->solidIndices;
+    const std::vector<float>& transparentVertices = meshArena->transparentVertices;
+    const std::vector<unsigned int>& transparentIndices = meshArena->transparentIndices;
 
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
+    // Solid
+    if (solidVAO == 0) {
+        setupMeshBuffers(solidVAO, solidVBO, solidEBO);
     }
     else {
         glBindVertexArray(solidVAO);
@@ -327,20 +525,7 @@ void Chunk::buildMesh() {
 
     // Transparent
     if (transparentVAO == 0) {
-        glGenVertexArrays(1, &transparentVAO);
-        glGenBuffers(1, &transparentVBO);
-        glGenBuffers(1, &transparentEBO);
-
-        glBindVertexArray(transparentVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, transparentVBO);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, transparentEBO);
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
+        setupMeshBuffers(transparentVAO, transparentVBO, transparentEBO);
     }
     else {
         glBindVertexArray(transparentVAO);
@@ -351,28 +536,296 @@ void Chunk::buildMesh() {
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, transparentEBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, transparentIndices.size() * sizeof(unsigned), transparentIndices.data(), GL_DYNAMIC_DRAW);
+
+    solidDrawCount = static_cast<int>(solidIndices.size());
+    transparentDrawCount = static_cast<int>(transparentIndices.size());
+
+    trackMeshUpload(solidUploadedVertices, solidUploadedIndices, solidVertices.size(), solidIndices.size());
+    trackMeshUpload(transparentUploadedVertices, transparentUploadedIndices, transparentVertices.size(), transparentIndices.size());
+    countMeshed();
+
+    MeshArenas::release(std::move(meshArena));
 }
 
+void Chunk::generateLodMesh(int level) {
+    PROFILE_ZONE("Chunk::generateLodMesh");
+
+    const int step = 1 << level;
+    const int cellsX = CHUNK_SIZE_X / step;
+    const int cellsY = (CHUNK_SIZE_Y + step - 1) / step;
+    const int cellsZ = CHUNK_SIZE_Z / step;
+
+    auto cellIndex = [cellsY, cellsZ](int cx, int cy, int cz) { return (cx * cellsY + cy) * cellsZ + cz; };
+
+    LodMesh& lod = lodMeshes[level - 1];
+    std::unique_ptr<MeshArena> arena = MeshArenas::acquire();
+    arena->reserveFaces(static_cast<size_t>(lod.uploadedIndices / 6), 0);
+
+    // Downsample. A cell is solid when at least half of its blocks are, and takes the type of
+    // its highest block so terrain keeps its top texture from afar
+    std::vector<UVHelper::BlockType>& cells = arena->lodCells;
+    cells.assign(cellsX * cellsY * cellsZ, UVHelper::BlockType::AIR);
+
+    for (int cx = 0; cx < cellsX; ++cx) {
+        for (int cy = 0; cy < cellsY; ++cy) {
+            for (int cz = 0; cz < cellsZ; ++cz) {
+                int solidCount = 0;
+                int volume = 0;
+                int topY = -1;
+                UVHelper::BlockType topType = UVHelper::BlockType::AIR;
+
+                for (int x = cx * step; x < (cx + 1) * step; ++x) {
+                    for (int y = cy * step; y < std::min((cy + 1) * step, (int)CHUNK_SIZE_Y); ++y) {
+                        for (int z = cz * step; z < (cz + 1) * step; ++z) {
+                            ++volume;
+
+                            UVHelper::BlockType type = ChunkData->blocks(x, y, z);
+                            if (type == UVHelper::BlockType::AIR) continue;
+
+                            ++solidCount;
+                            if (y >= topY) {
+                                topY = y;
+                                topType = type;
+                            }
+                        }
+                    }
+                }
 
-void Chunk::render(Shader& ourShader) {
-    if (solidVAO == 0 || transparentVAO == 0) {
-        regenMesh();
+                if (solidCount * 2 >= volume) {
+                    cells[cellIndex(cx, cy, cz)] = topType;
+                }
+            }
+        }
     }
 
+    // Highest solid cell per column, skirts only need to reach a little below it
+    std::vector<int>& columnTop = arena->lodColumnTops;
+    columnTop.assign(cellsX * cellsZ, -1);
+    for (int cx = 0; cx < cellsX; ++cx) {
+        for (int cz = 0; cz < cellsZ; ++cz) {
+            for (int cy = cellsY - 1; cy >= 0; --cy) {
+                if (cells[cellIndex(cx, cy, cz)] != UVHelper::BlockType::AIR) {
+                    columnTop[cx * cellsZ + cz] = cy;
+                    break;
+                }
+            }
+        }
+    }
+    const int skirtDepth = 2;
+
+    unsigned int indexCount = 0;
+
+    const float size = static_cast<float>(step);
+
+    for (int cx = 0; cx < cellsX; ++cx) {
+        for (int cy = 0; cy < cellsY; ++cy) {
+            for (int cz = 0; cz < cellsZ; ++cz) {
+                UVHelper::BlockType type = cells[cellIndex(cx, cy, cz)];
+                if (type == UVHelper::BlockType::AIR) continue;
+
+                glm::vec3 center = glm::vec3(cx, cy, cz) * size + (size * 0.5f - 0.5f);
+
+                for (int face = 0; face < 6; face++) {
+                    int nx = cx, ny = cy, nz = cz;
+
+                    // Same face order as generateMesh
+                    if (face == 0) nz--;
+                    if (face == 1) nz++;
+                    if (face == 2) nx--;
+                    if (face == 3) nx++;
+                    if (face == 4) ny--;
+                    if (face == 5) ny++;
+
+                    if (ny < 0) continue;
+
+                    // Faces on the chunk border near the surface are always kept. They act as skirts
+                    // that hide the cracks against neighbors drawn at a different level
+                    bool shouldRenderFace = true;
+                    if (nx >= 0 && nx < cellsX && nz >= 0 && nz < cellsZ && ny < cellsY) {
+                        shouldRenderFace = isNeighborClear(cells[cellIndex(nx, ny, nz)], type);
+                    }
+                    else if (ny < cellsY) {
+                        shouldRenderFace = cy >= columnTop[cx * cellsZ + cz] - skirtDepth;
+                    }
+
+                    if (shouldRenderFace) {
+                        appendFace(arena->solidVertices, arena->solidIndices, indexCount, face, center, size, type);
+                    }
+                }
+            }
+        }
+    }
+
+    MeshArenas::release(std::move(lod.arena));
+    lod.arena = std::move(arena);
+}
+
+void Chunk::uploadFinishedLodMesh(int level) {
+    LodMesh& lod = lodMeshes[level - 1];
+    if (!lod.future.valid() || lod.future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) return;
+
+    PROFILE_ZONE("Chunk::uploadLodMesh");
+
+    lod.future.get();
+    lod.future = std::future<void>();
+
+    if (lod.VAO == 0) {
+        setupMeshBuffers(lod.VAO, lod.VBO, lod.EBO);
+    }
+    else {
+        glBindVertexArray(lod.VAO);
+    }
+
+    const std::vector<float>& vertices = lod.arena->solidVertices;
+    const std::vector<unsigned int>& indices = lod.arena->solidIndices;
+
+    glBindBuffer(GL_ARRAY_BUFFER, lod.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned), indices.data(), GL_DYNAMIC_DRAW);
+
+    lod.drawCount = static_cast<int>(indices.size());
+    lod.builtGeneration = lod.meshingGeneration;
+
+    trackMeshUpload(lod.uploadedVertices, lod.uploadedIndices, vertices.size(), indices.size());
+    countMeshed();
+
+    MeshArenas::release(std::move(lod.arena));
+}
+
+void Chunk::countMeshed() {
+    if (!countedAsMeshed) {
+        countedAsMeshed = true;
+        ++Stats::chunksMeshed;
+    }
+}
+
+void Chunk::uploadFinishedMesh() {
     if (meshFuture.valid() && meshFuture.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
         meshFuture.get();
         buildMesh();
         meshFuture = std::future<void>();
+        builtGeneration = meshingGeneration;
+
+        // The new index buffer is in mesh order again
+        sortFaceCenters = std::make_shared<const std::vector<glm::vec3>>(std::move(transparentFaceCenters));
+        transparentFaceCenters = std::vector<glm::vec3>();
+        transparentSorted = false;
+    }
+}
+
+bool Chunk::isLodReady(int level) const {
+    if (level == 0) return solidVAO != 0 && transparentVAO != 0;
+    return lodMeshes[level - 1].VAO != 0;
+}
+
+int Chunk::getLodLevel() const {
+    return lodLevel;
+}
+
+void Chunk::updateLod(float distance) {
+    uploadFinishedMesh();
+    for (int level = 1; level < LOD_LEVELS; ++level) {
+        uploadFinishedLodMesh(level);
+    }
+
+    int target = lodLevel;
+    while (target < LOD_LEVELS - 1 && distance > LOD_SWITCH_DISTANCE[target] + LOD_HYSTERESIS) ++target;
+    while (target > 0 && distance < LOD_SWITCH_DISTANCE[target - 1] - LOD_HYSTERESIS) --target;
+
+    // Edits made since the last job, including ones that landed while it ran
+    unsigned int targetGeneration = target == 0 ? builtGeneration : lodMeshes[target - 1].builtGeneration;
+    if (!isLodReady(target) || targetGeneration != editGeneration) {
+        launchMeshJob(target);
+    }
+
+    if (isLodReady(target) || !isLodReady(lodLevel)) {
+        lodLevel = target;
     }
+}
+
+void Chunk::renderSolid(Shader& ourShader) {
     ourShader.setFloat("opacity", 1.0f);
-    glBindVertexArray(solidVAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(solidIndices.size()), GL_UNSIGNED_INT, 0);
+
+    unsigned int vao = solidVAO;
+    int drawCount = solidDrawCount;
+    if (lodLevel > 0) {
+        vao = lodMeshes[lodLevel - 1].VAO;
+        drawCount = lodMeshes[lodLevel - 1].drawCount;
+    }
+    if (drawCount == 0) return;
+
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, 0);
+    ++Stats::chunksDrawn;
+    ++Stats::drawCalls;
+}
+
+bool Chunk::hasTransparentFaces() const {
+    // Lower levels fold transparent blocks into their single mesh
+    return lodLevel == 0 && transparentDrawCount > 0;
+}
+
+void Chunk::renderTransparent(Shader& ourShader, const glm::vec3& cameraPos) {
+    if (sortFuture.valid() && sortFuture.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
+        TransparentSort sorted = sortFuture.get();
+
+        // Drop results for a mesh that has since been replaced
+        if (sorted.faceCenters == sortFaceCenters && static_cast<int>(sorted.indices.size()) == transparentDrawCount) {
+            PROFILE_ZONE("Chunk::uploadSortedIndices");
+            // The element buffer binding belongs to the bound VAO, binding it under another
+            // chunk's VAO would swap that chunk's indices for these
+            glBindVertexArray(transparentVAO);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, transparentEBO);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sorted.indices.size() * sizeof(unsigned), sorted.indices.data());
+            Stats::bytesUploaded += sorted.indices.size() * sizeof(unsigned);
+        }
+        else {
+            transparentSorted = false;
+        }
+    }
+
+    glm::ivec3 cameraCell = glm::ivec3(glm::round(cameraPos));
+    if (sortFaceCenters && !sortFuture.valid() && (!transparentSorted || cameraCell != sortedCameraCell)) {
+        sortedCameraCell = cameraCell;
+        transparentSorted = true;
+
+        std::shared_ptr<const std::vector<glm::vec3>> faceCenters = sortFaceCenters;
+        glm::vec3 eye = cameraPos;
+        sortFuture = std::async(std::launch::async, [faceCenters, eye] {
+            PROFILE_ZONE("Chunk::sortTransparentFaces");
+
+            const std::vector<glm::vec3>& centers = *faceCenters;
+
+            std::vector<std::pair<float, unsigned int>> order(centers.size());
+            for (unsigned int face = 0; face < centers.size(); ++face) {
+                glm::vec3 d = centers[face] - eye;
+                order[face] = { glm::dot(d, d), face };
+            }
+            std::sort(order.begin(), order.end(), [](const std::pair<float, unsigned int>& a, const std::pair<float, unsigned int>& b) {
+                return a.first > b.first;
+            });
+
+            // Every face owns six consecutive vertices
+            TransparentSort sorted;
+            sorted.faceCenters = faceCenters;
+            sorted.indices.reserve(order.size() * 6);
+            for (const std::pair<float, unsigned int>& entry : order) {
+                for (unsigned int vertex = 0; vertex < 6; ++vertex) {
+                    sorted.indices.push_back(entry.second * 6 + vertex);
+                }
+            }
+            return sorted;
+        });
+    }
 
     glDisable(GL_CULL_FACE);
 
     ourShader.setFloat("opacity", 0.85f);
     glBindVertexArray(transparentVAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(transparentIndices.size()), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, transparentDrawCount, GL_UNSIGNED_INT, 0);
+    ++Stats::drawCalls;
 
     glEnable(GL_CULL_FACE);
 }
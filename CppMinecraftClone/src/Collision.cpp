@@ -0,0 +1,97 @@
+#include "headerfiles/Collision.hpp"
+#include "headerfiles/World.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Contacts closer than this count as touching rather than overlapping, so float error
+    // after a clip doesn't catch the box on the face it rests against
+    constexpr float EPSILON = 1e-4f;
+
+    // Clips the displacement along one axis against a block the box lines up with on the others
+    float clipAxis(const Collision::AABB& box, const Collision::AABB& block, int axis, float distance) {
+        for (int other = 0; other < 3; ++other) {
+            if (other == axis) continue;
+            if (box.max[other] <= block.min[other] + EPSILON || box.min[other] >= block.max[other] - EPSILON) return distance;
+        }
+
+        if (distance > 0.0f && box.max[axis] <= block.min[axis] + EPSILON) {
+            distance = std::min(distance, block.min[axis] - box.max[axis]);
+        }
+        else if (distance < 0.0f && box.min[axis] >= block.max[axis] - EPSILON) {
+            distance = std::max(distance, block.max[axis] - box.min[axis]);
+        }
+        return distance;
+    }
+}
+
+namespace Collision {
+    bool isSolid(UVHelper::BlockType blockType) {
+        return blockType != UVHelper::BlockType::AIR;
+    }
+
+    AABB blockBox(const glm::ivec3& blockPos) {
+        glm::vec3 center(blockPos);
+        return { center - glm::vec3(0.5f), center + glm::vec3(0.5f) };
+    }
+
+    bool overlaps(const AABB& a, const AABB& b) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (a.max[axis] <= b.min[axis] + EPSILON || a.min[axis] >= b.max[axis] - EPSILON) return false;
+        }
+        return true;
+    }
+
+    SweepResult sweep(const AABB& box, const glm::vec3& displacement) {
+        SweepResult result;
+        result.moved = glm::vec3(0.0f);
+        result.contactNormal = glm::ivec3(0);
+        result.voxelsTested = 0;
+
+        // Blocks span +-0.5 around integer coordinates, so a range touching a block's face
+        // without entering it doesn't include that block
+        glm::vec3 sweptMin = glm::min(box.min, box.min + displacement);
+        glm::vec3 sweptMax = glm::max(box.max, box.max + displacement);
+        glm::ivec3 first(glm::floor(sweptMin + glm::vec3(0.5f)));
+        glm::ivec3 last(glm::ceil(sweptMax - glm::vec3(0.5f)));
+        first.y = std::max(first.y, 0);
+        last.y = std::min(last.y, static_cast<int>(CHUNK_SIZE_Y) - 1);
+
+        // Reused between calls, entity updates sweep thousands of boxes per tick
+        thread_local std::vector<AABB> solidBlocks;
+        solidBlocks.clear();
+        for (int x = first.x; x <= last.x; ++x) {
+            for (int z = first.z; z <= last.z; ++z) {
+                for (int y = first.y; y <= last.y; ++y) {
+                    ++result.voxelsTested;
+                    if (isSolid(getWorldBlock(x, y, z))) {
+                        solidBlocks.push_back(blockBox(glm::ivec3(x, y, z)));
+                    }
+                }
+            }
+        }
+
+        AABB moving = box;
+        const int axisOrder[3] = { 1, 0, 2 };
+        for (int axis : axisOrder) {
+            float distance = displacement[axis];
+            if (distance == 0.0f) continue;
+
+            for (const AABB& block : solidBlocks) {
+                distance = clipAxis(moving, block, axis, distance);
+            }
+
+            if (distance != displacement[axis]) {
+                result.contactNormal[axis] = displacement[axis] > 0.0f ? -1 : 1;
+            }
+
+            moving.min[axis] += distance;
+            moving.max[axis] += distance;
+            result.moved[axis] = distance;
+        }
+
+        return result;
+    }
+}
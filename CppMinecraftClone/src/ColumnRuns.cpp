@@ -0,0 +1,81 @@
+#include "headerfiles/ColumnRuns.hpp"
+#include "headerfiles/Profiler.hpp"
+
+#include <algorithm>
+
+void ColumnRuns::encode(const ChunkBlocks& blocks) {
+    PROFILE_ZONE("ColumnRuns::encode");
+
+    columnStart.clear();
+    runs.clear();
+    columnStart.reserve(CHUNK_SIZE_X * CHUNK_SIZE_Z + 1);
+
+    for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+        for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+            columnStart.push_back(static_cast<uint32_t>(runs.size()));
+
+            UVHelper::BlockType current = blocks(x, 0, z);
+            for (int y = 1; y < CHUNK_SIZE_Y; ++y) {
+                if (blocks(x, y, z) != current) {
+                    runs.push_back({ current, static_cast<uint8_t>(y) });
+                    current = blocks(x, y, z);
+                }
+            }
+            runs.push_back({ current, static_cast<uint8_t>(CHUNK_SIZE_Y) });
+        }
+    }
+    columnStart.push_back(static_cast<uint32_t>(runs.size()));
+
+    runs.shrink_to_fit();
+}
+
+void ColumnRuns::decode(ChunkBlocks& blocks) const {
+    PROFILE_ZONE("ColumnRuns::decode");
+
+    for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+        for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+            int column = columnIndex(x, z);
+            int y = 0;
+            for (uint32_t run = columnStart[column]; run < columnStart[column + 1]; ++run) {
+                for (; y < runs[run].end; ++y) {
+                    blocks(x, y, z) = runs[run].type;
+                }
+            }
+        }
+    }
+}
+
+bool ColumnRuns::assign(const std::vector<Run>& allRuns) {
+    columnStart.clear();
+    runs = allRuns;
+
+    int previousEnd = 0;
+    for (uint32_t run = 0; run < runs.size(); ++run) {
+        if (previousEnd == 0) {
+            columnStart.push_back(run);
+        }
+        if (runs[run].end <= previousEnd || runs[run].end > CHUNK_SIZE_Y) return false;
+        // Types past the last block would index out of the texture and property tables
+        if (runs[run].type > UVHelper::BlockType::SAND) return false;
+        previousEnd = runs[run].end == CHUNK_SIZE_Y ? 0 : runs[run].end;
+    }
+    columnStart.push_back(static_cast<uint32_t>(runs.size()));
+
+    return previousEnd == 0 && columnStart.size() == CHUNK_SIZE_X * CHUNK_SIZE_Z + 1;
+}
+
+UVHelper::BlockType ColumnRuns::getBlock(int x, int y, int z) const {
+    int column = columnIndex(x, z);
+    const Run* first = runs.data() + columnStart[column];
+    const Run* last = runs.data() + columnStart[column + 1];
+
+    // First run ending above y
+    const Run* run = std::upper_bound(first, last, y, [](int height, const Run& candidate) {
+        return height < candidate.end;
+    });
+    return run->type;
+}
+
+size_t ColumnRuns::getByteSize() const {
+    return columnStart.capacity() * sizeof(uint32_t) + runs.capacity() * sizeof(Run);
+}
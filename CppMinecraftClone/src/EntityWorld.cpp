@@ -0,0 +1,424 @@
+#include "headerfiles/EntityWorld.hpp"
+#include "headerfiles/Collision.hpp"
+#include "headerfiles/Constants.hpp"
+#include "headerfiles/World.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/Stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glad/glad.h>
+
+namespace {
+    // Marks ids that don't belong to a live entity
+    constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    struct TypeInfo {
+        float halfWidth;
+        float height;
+        float gravity;
+        // Seconds until the entity despawns on its own, zero keeps it forever
+        float lifetime;
+        glm::vec3 color;
+    };
+
+    const TypeInfo TYPE_INFO[] = {
+        { 0.125f, 0.25f, 25.0f, 300.0f, glm::vec3(1.0f) },              // ITEM, tinted by its block
+        { 0.3f,   1.8f,  25.0f, 0.0f,   glm::vec3(0.85f, 0.55f, 0.6f) }, // MOB
+        { 0.05f,  0.1f,  10.0f, 10.0f,  glm::vec3(0.95f, 0.9f, 0.6f) },  // PROJECTILE
+    };
+
+    const glm::vec3 BLOCK_COLORS[] = {
+        glm::vec3(1.0f),               // AIR
+        glm::vec3(0.35f, 0.65f, 0.25f), // GRASS
+        glm::vec3(0.5f, 0.35f, 0.2f),   // DIRT
+        glm::vec3(0.5f, 0.5f, 0.5f),    // STONE
+        glm::vec3(0.45f, 0.33f, 0.2f),  // OAK LOG
+        glm::vec3(0.2f, 0.5f, 0.15f),   // OAK LEAVES
+        glm::vec3(0.2f, 0.35f, 0.8f),   // WATER
+        glm::vec3(0.3f, 0.3f, 0.3f),    // COAL ORE
+        glm::vec3(0.6f, 0.5f, 0.45f),   // IRON ORE
+        glm::vec3(0.86f, 0.83f, 0.63f), // SAND
+    };
+
+    constexpr float TERMINAL_VELOCITY = 40.0f;
+    constexpr float MOB_WALK_SPEED = 2.0f;
+    constexpr float MOB_JUMP_SPEED = 8.0f;
+    constexpr float ITEM_GROUND_FRICTION = 8.0f;
+    constexpr float PROJECTILE_HIT_RADIUS = 0.4f;
+
+    const TypeInfo& info(EntityType type) {
+        return TYPE_INFO[static_cast<int>(type)];
+    }
+
+    Collision::AABB entityBox(EntityType type, const glm::vec3& position) {
+        const TypeInfo& typeInfo = info(type);
+        return {
+            position - glm::vec3(typeInfo.halfWidth, 0.0f, typeInfo.halfWidth),
+            position + glm::vec3(typeInfo.halfWidth, typeInfo.height, typeInfo.halfWidth)
+        };
+    }
+
+    int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    // Block columns are centered on integers, so column c covers [c - 0.5, c + 0.5)
+    int blockCoord(float value) {
+        return static_cast<int>(std::floor(value + 0.5f));
+    }
+
+    // Past the world's edge there are no blocks to land on, entities there would fall forever
+    bool insideWorld(const glm::vec3& position) {
+        int x = blockCoord(position.x);
+        int z = blockCoord(position.z);
+        return position.y >= 0.0f && x >= 0 && x < (int)(WORLD_SIZE_X * CHUNK_SIZE_X) &&
+            z >= 0 && z < (int)(WORLD_SIZE_Z * CHUNK_SIZE_Z);
+    }
+
+    int64_t chunkKey(int chunkX, int chunkZ) {
+        return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkZ);
+    }
+
+    int64_t chunkKeyAt(const glm::vec3& position) {
+        return chunkKey(floorDiv(blockCoord(position.x), CHUNK_SIZE_X), floorDiv(blockCoord(position.z), CHUNK_SIZE_Z));
+    }
+
+    // Cheap deterministic noise so mob behavior replays identically
+    uint32_t hash(uint32_t a, uint32_t b) {
+        uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u + (a << 6) + (a >> 2));
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        return h;
+    }
+}
+
+EntityWorld::~EntityWorld() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &cubeVBO);
+        glDeleteBuffers(1, &instanceVBO);
+    }
+}
+
+EntityId EntityWorld::spawn(EntityType type, const glm::vec3& position, const glm::vec3& velocity, UVHelper::BlockType block) {
+    EntityId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else {
+        id = static_cast<EntityId>(denseIndex.size());
+        denseIndex.push_back(INVALID_INDEX);
+    }
+
+    denseIndex[id] = static_cast<uint32_t>(ids.size());
+    ids.push_back(id);
+    types.push_back(type);
+    blocks.push_back(block);
+    positions.push_back(position);
+    previousPositions.push_back(position);
+    velocities.push_back(velocity);
+    ages.push_back(0.0f);
+    wanderTimers.push_back(0.0f);
+    grounded.push_back(0);
+
+    return id;
+}
+
+void EntityWorld::despawn(EntityId id) {
+    if (isAlive(id)) pendingDespawns.push_back(id);
+}
+
+bool EntityWorld::isAlive(EntityId id) const {
+    return id < denseIndex.size() && denseIndex[id] != INVALID_INDEX;
+}
+
+size_t EntityWorld::count() const {
+    return ids.size();
+}
+
+glm::vec3 EntityWorld::getPosition(EntityId id) const {
+    return positions[denseIndex[id]];
+}
+
+EntityType EntityWorld::getType(EntityId id) const {
+    return types[denseIndex[id]];
+}
+
+float EntityWorld::getAge(EntityId id) const {
+    return ages[denseIndex[id]];
+}
+
+void EntityWorld::update(float deltaTime) {
+    PROFILE_ZONE("EntityWorld::update");
+    uint64_t startNs = Profiler::now();
+
+    ++tick;
+    previousPositions = positions;
+
+    // Both passes only touch entity i while handling it, so the ranges can later be split
+    // across worker threads
+    integrate(0, ids.size(), deltaTime);
+    collide(0, ids.size(), deltaTime);
+
+    rebuildSpatialHash();
+
+    // Projectiles take out the first mob they reach
+    std::vector<EntityId> nearby;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (types[i] != EntityType::PROJECTILE) continue;
+
+        nearby.clear();
+        queryRadius(positions[i], info(EntityType::MOB).halfWidth + PROJECTILE_HIT_RADIUS, nearby);
+        for (EntityId other : nearby) {
+            if (getType(other) != EntityType::MOB) continue;
+
+            despawn(other);
+            despawn(ids[i]);
+            break;
+        }
+    }
+
+    if (!pendingDespawns.empty()) {
+        for (EntityId id : pendingDespawns) {
+            if (isAlive(id)) removeAt(denseIndex[id]);
+        }
+        pendingDespawns.clear();
+        rebuildSpatialHash();
+    }
+
+    Stats::entityCount = static_cast<int>(ids.size());
+    Stats::entityUpdateNs = static_cast<int64_t>(Profiler::now() - startNs);
+}
+
+void EntityWorld::integrate(size_t begin, size_t end, float deltaTime) {
+    for (size_t i = begin; i < end; ++i) {
+        const TypeInfo& typeInfo = info(types[i]);
+        glm::vec3& velocity = velocities[i];
+
+        velocity.y = std::max(velocity.y - typeInfo.gravity * deltaTime, -TERMINAL_VELOCITY);
+
+        if (types[i] == EntityType::MOB) {
+            wanderTimers[i] -= deltaTime;
+            if (wanderTimers[i] <= 0.0f) {
+                uint32_t h = hash(ids[i], tick);
+                float angle = (h & 0xFFFF) / 65536.0f * 6.2831853f;
+                float speed = (h >> 16) % 3 == 0 ? 0.0f : MOB_WALK_SPEED;
+
+                velocity.x = std::cos(angle) * speed;
+                velocity.z = std::sin(angle) * speed;
+                wanderTimers[i] = 2.0f + ((h >> 20) % 4);
+            }
+        }
+        else if (types[i] == EntityType::ITEM && grounded[i]) {
+            float damping = std::max(0.0f, 1.0f - ITEM_GROUND_FRICTION * deltaTime);
+            velocity.x *= damping;
+            velocity.z *= damping;
+            if (std::abs(velocity.x) < 0.01f && std::abs(velocity.z) < 0.01f) {
+                velocity.x = 0.0f;
+                velocity.z = 0.0f;
+            }
+        }
+
+        ages[i] += deltaTime;
+        if ((typeInfo.lifetime > 0.0f && ages[i] > typeInfo.lifetime) || !insideWorld(positions[i])) {
+            pendingDespawns.push_back(ids[i]);
+        }
+    }
+}
+
+void EntityWorld::collide(size_t begin, size_t end, float deltaTime) {
+    for (size_t i = begin; i < end; ++i) {
+        glm::vec3& position = positions[i];
+        glm::vec3& velocity = velocities[i];
+        EntityType type = types[i];
+
+        // Resting entities only check that the block under them is still there, most
+        // dropped items spend their life like this
+        if (grounded[i] && velocity.x == 0.0f && velocity.z == 0.0f) {
+            glm::ivec3 below(blockCoord(position.x), blockCoord(position.y - 0.01f), blockCoord(position.z));
+            if (Collision::isSolid(getWorldBlock(below.x, below.y, below.z))) {
+                velocity.y = 0.0f;
+                continue;
+            }
+        }
+
+        Collision::SweepResult result = Collision::sweep(entityBox(type, position), velocity * deltaTime);
+        position += result.moved;
+        grounded[i] = result.contactNormal.y > 0;
+
+        if (result.contactNormal != glm::ivec3(0)) {
+            if (type == EntityType::PROJECTILE) {
+                pendingDespawns.push_back(ids[i]);
+                continue;
+            }
+
+            if (result.contactNormal.y != 0) velocity.y = 0.0f;
+
+            // Mobs keep pushing in their walking direction and hop over single blocks
+            if (type == EntityType::MOB) {
+                if (grounded[i] && (result.contactNormal.x != 0 || result.contactNormal.z != 0)) {
+                    velocity.y = MOB_JUMP_SPEED;
+                }
+            }
+            else {
+                if (result.contactNormal.x != 0) velocity.x = 0.0f;
+                if (result.contactNormal.z != 0) velocity.z = 0.0f;
+            }
+        }
+    }
+}
+
+void EntityWorld::removeAt(uint32_t index) {
+    EntityId removed = ids[index];
+    uint32_t last = static_cast<uint32_t>(ids.size() - 1);
+
+    if (index != last) {
+        ids[index] = ids[last];
+        types[index] = types[last];
+        blocks[index] = blocks[last];
+        positions[index] = positions[last];
+        previousPositions[index] = previousPositions[last];
+        velocities[index] = velocities[last];
+        ages[index] = ages[last];
+        wanderTimers[index] = wanderTimers[last];
+        grounded[index] = grounded[last];
+
+        denseIndex[ids[index]] = index;
+    }
+
+    ids.pop_back();
+    types.pop_back();
+    blocks.pop_back();
+    positions.pop_back();
+    previousPositions.pop_back();
+    velocities.pop_back();
+    ages.pop_back();
+    wanderTimers.pop_back();
+    grounded.pop_back();
+
+    denseIndex[removed] = INVALID_INDEX;
+    freeIds.push_back(removed);
+}
+
+void EntityWorld::rebuildSpatialHash() {
+    // Buckets that stay occupied keep their storage between ticks
+    for (auto& bucket : spatialHash) {
+        bucket.second.clear();
+    }
+
+    for (uint32_t i = 0; i < ids.size(); ++i) {
+        spatialHash[chunkKeyAt(positions[i])].push_back(i);
+    }
+
+    // Chunks every entity has left, otherwise the map grows with every chunk ever visited
+    for (auto bucket = spatialHash.begin(); bucket != spatialHash.end();) {
+        if (bucket->second.empty()) {
+            bucket = spatialHash.erase(bucket);
+        }
+        else {
+            ++bucket;
+        }
+    }
+}
+
+void EntityWorld::queryRadius(const glm::vec3& center, float radius, std::vector<EntityId>& out) const {
+    int minChunkX = floorDiv(blockCoord(center.x - radius), CHUNK_SIZE_X);
+    int maxChunkX = floorDiv(blockCoord(center.x + radius), CHUNK_SIZE_X);
+    int minChunkZ = floorDiv(blockCoord(center.z - radius), CHUNK_SIZE_Z);
+    int maxChunkZ = floorDiv(blockCoord(center.z + radius), CHUNK_SIZE_Z);
+
+    float radiusSquared = radius * radius;
+    for (int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+        for (int chunkZ = minChunkZ; chunkZ <= maxChunkZ; ++chunkZ) {
+            auto bucket = spatialHash.find(chunkKey(chunkX, chunkZ));
+            if (bucket == spatialHash.end()) continue;
+
+            for (uint32_t index : bucket->second) {
+                glm::vec3 offset = positions[index] - center;
+                if (glm::dot(offset, offset) <= radiusSquared) out.push_back(ids[index]);
+            }
+        }
+    }
+}
+
+void EntityWorld::loadAssets(AssetManager& assets) {
+    if (shader) return;
+
+    shader = assets.loadShader("src/shaders/vs/entity.vs", "src/shaders/fs/entity.fs");
+    shader->onLoad = [](Shader& program) {
+        // Same light as the chunk shader
+        glm::vec3 lightColor(0.8f, 0.8f, 0.7f);
+        glm::vec3 lightDir(-0.2f, -1.0f, -0.3f);
+        program.use();
+        program.setVec3("lightColor", lightColor);
+        program.setVec3("lightDir", lightDir);
+    };
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &cubeVBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertexData), vertexData, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glBindVertexArray(0);
+}
+
+void EntityWorld::render(Camera& cam, float alpha) {
+    if (ids.empty() || !isReady()) return;
+
+    PROFILE_ZONE("EntityWorld::render");
+
+    instanceData.resize(ids.size() * 8);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const TypeInfo& typeInfo = info(types[i]);
+        glm::vec3 position = glm::mix(previousPositions[i], positions[i], alpha);
+        glm::vec3 color = types[i] == EntityType::ITEM ? BLOCK_COLORS[blocks[i]] : typeInfo.color;
+
+        float* instance = &instanceData[i * 8];
+        instance[0] = position.x;
+        instance[1] = position.y;
+        instance[2] = position.z;
+        instance[3] = typeInfo.halfWidth;
+        instance[4] = color.r;
+        instance[5] = color.g;
+        instance[6] = color.b;
+        instance[7] = typeInfo.height;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    size_t bytes = instanceData.size() * sizeof(float);
+    if (bytes > instanceCapacity) {
+        instanceCapacity = bytes * 2;
+    }
+    // Orphaned every frame so the driver doesn't wait on the previous draw
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instanceData.data());
+    Stats::bytesUploaded += bytes;
+
+    Shader& program = shader->get();
+    program.use();
+    cam.setProjection(program);
+    cam.setCamera(program);
+
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(ids.size()));
+    glBindVertexArray(0);
+    ++Stats::drawCalls;
+}
@@ -0,0 +1,200 @@
+#include "headerfiles/FarTerrain.hpp"
+#include "headerfiles/Chunk.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/Stats.hpp"
+#include "headerfiles/TerrainGenerator.hpp"
+#include "headerfiles/UVHelper.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+FarTerrain::~FarTerrain() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+
+    Stats::farTerrainBytes -= uploadedBytes;
+}
+
+float FarTerrain::getViewDistance() {
+    return static_cast<float>(FAR_TERRAIN_GRID / 2 * (FAR_TERRAIN_CELL_SIZE << (FAR_TERRAIN_RINGS - 1)));
+}
+
+bool FarTerrain::sameLayout(const Layout& a, const Layout& b) {
+    for (int ring = 0; ring < FAR_TERRAIN_RINGS; ++ring) {
+        if (a.ringCenters[ring] != b.ringCenters[ring]) return false;
+    }
+    return a.holeMin == b.holeMin && a.holeMax == b.holeMax;
+}
+
+void FarTerrain::update(const glm::vec3& cameraPos, int renderDistance) {
+    if (meshFuture.valid() && meshFuture.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
+        PROFILE_ZONE("FarTerrain::upload");
+
+        MeshData mesh = meshFuture.get();
+        meshFuture = std::future<MeshData>();
+
+        if (VAO == 0) {
+            setupMeshBuffers(VAO, VBO, EBO);
+        }
+        else {
+            glBindVertexArray(VAO);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), mesh.vertices.data(), GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(unsigned), mesh.indices.data(), GL_STATIC_DRAW);
+
+        drawCount = static_cast<int>(mesh.indices.size());
+
+        int64_t bytes = static_cast<int64_t>(mesh.vertices.size() * sizeof(float) + mesh.indices.size() * sizeof(unsigned));
+        Stats::farTerrainBytes += bytes - uploadedBytes;
+        Stats::bytesUploaded += bytes;
+        uploadedBytes = bytes;
+    }
+
+    Layout layout;
+    for (int ring = 0; ring < FAR_TERRAIN_RINGS; ++ring) {
+        // Snapping to twice the cell size keeps every ring's edge on the next ring's grid
+        float snap = static_cast<float>(2 * (FAR_TERRAIN_CELL_SIZE << ring));
+        layout.ringCenters[ring] = glm::ivec2(
+            static_cast<int>(std::floor(cameraPos.x / snap) * snap),
+            static_cast<int>(std::floor(cameraPos.z / snap) * snap));
+    }
+
+    // Same bounds renderWorld draws chunks in
+    int playerChunkX = cameraPos.x / CHUNK_SIZE_X;
+    int playerChunkZ = cameraPos.z / CHUNK_SIZE_Z;
+
+    layout.holeMin = glm::ivec2(std::max(0, playerChunkX - renderDistance) * CHUNK_SIZE_X,
+        std::max(0, playerChunkZ - renderDistance) * CHUNK_SIZE_Z);
+    layout.holeMax = glm::ivec2(std::min((int)WORLD_SIZE_X, playerChunkX + renderDistance + 1) * CHUNK_SIZE_X,
+        std::min((int)WORLD_SIZE_Z, playerChunkZ + renderDistance + 1) * CHUNK_SIZE_Z);
+    layout.holeMax = glm::max(layout.holeMin, layout.holeMax);
+
+    if ((!hasLayout || !sameLayout(layout, requestedLayout)) && !meshFuture.valid()) {
+        requestedLayout = layout;
+        hasLayout = true;
+        meshFuture = std::async(std::launch::async, [layout] { return buildMesh(layout); });
+    }
+}
+
+FarTerrain::MeshData FarTerrain::buildMesh(const Layout& layout) {
+    PROFILE_ZONE("FarTerrain::buildMesh");
+
+    MeshData mesh;
+
+    const int vertsPerSide = FAR_TERRAIN_GRID + 1;
+
+    // Vertices take the top texture of their biome's surface block, at this distance its mip
+    // levels average it to one color. Vertices are too far apart to share the generator's
+    // climate regions, so climate is read from the noise directly and the cache is left alone
+    std::vector<float> heights(vertsPerSide * vertsPerSide);
+    std::vector<float> layers(vertsPerSide * vertsPerSide);
+
+    for (int ring = 0; ring < FAR_TERRAIN_RINGS; ++ring) {
+        const int cellSize = FAR_TERRAIN_CELL_SIZE << ring;
+        const glm::ivec2 origin = layout.ringCenters[ring] - glm::ivec2(FAR_TERRAIN_GRID / 2 * cellSize);
+
+        // Cells fully inside the previous ring or the chunk area are skipped
+        glm::ivec2 innerMin = layout.holeMin;
+        glm::ivec2 innerMax = layout.holeMax;
+        glm::ivec2 ringInnerMin = innerMin, ringInnerMax = innerMin;
+        if (ring > 0) {
+            int innerHalf = FAR_TERRAIN_GRID / 2 * (cellSize / 2);
+            ringInnerMin = layout.ringCenters[ring - 1] - glm::ivec2(innerHalf);
+            ringInnerMax = layout.ringCenters[ring - 1] + glm::ivec2(innerHalf);
+        }
+
+        for (int i = 0; i < vertsPerSide; ++i) {
+            for (int j = 0; j < vertsPerSide; ++j) {
+                int x = origin.x + i * cellSize;
+                int z = origin.y + j * cellSize;
+                Biomes::ColumnClimate column = Biomes::sampleUncached(x, z);
+                heights[i * vertsPerSide + j] = static_cast<float>(TerrainGenerator::terrainHeight(
+                    static_cast<float>(x), static_cast<float>(z), column));
+
+                Biomes::BiomeType biome = Biomes::surfaceBiome(column, x, z);
+                layers[i * vertsPerSide + j] = static_cast<float>(UVHelper::getTileLayer(Biomes::getBiome(biome).surface, 5));
+            }
+        }
+
+        // Odd vertices on the outer edge sit halfway along an edge of the next ring's cell,
+        // matching its interpolated height closes the cracks between rings
+        for (int k = 1; k < FAR_TERRAIN_GRID; k += 2) {
+            const int last = FAR_TERRAIN_GRID;
+            heights[0 * vertsPerSide + k] = 0.5f * (heights[0 * vertsPerSide + k - 1] + heights[0 * vertsPerSide + k + 1]);
+            heights[last * vertsPerSide + k] = 0.5f * (heights[last * vertsPerSide + k - 1] + heights[last * vertsPerSide + k + 1]);
+            heights[k * vertsPerSide + 0] = 0.5f * (heights[(k - 1) * vertsPerSide + 0] + heights[(k + 1) * vertsPerSide + 0]);
+            heights[k * vertsPerSide + last] = 0.5f * (heights[(k - 1) * vertsPerSide + last] + heights[(k + 1) * vertsPerSide + last]);
+        }
+
+        unsigned int baseVertex = static_cast<unsigned int>(mesh.vertices.size() / TERRAIN_VERTEX_FLOATS);
+
+        for (int i = 0; i < vertsPerSide; ++i) {
+            for (int j = 0; j < vertsPerSide; ++j) {
+                float height = heights[i * vertsPerSide + j];
+
+                float left = heights[std::max(i - 1, 0) * vertsPerSide + j];
+                float right = heights[std::min(i + 1, FAR_TERRAIN_GRID) * vertsPerSide + j];
+                float back = heights[i * vertsPerSide + std::max(j - 1, 0)];
+                float front = heights[i * vertsPerSide + std::min(j + 1, FAR_TERRAIN_GRID)];
+                glm::vec3 normal = glm::normalize(glm::vec3(left - right, 2.0f * cellSize, back - front));
+
+                // Grid lines sit on block edges, the top face of a column is at height - 0.5
+                mesh.vertices.push_back(origin.x + i * cellSize - 0.5f);
+                mesh.vertices.push_back(height - 0.5f);
+                mesh.vertices.push_back(origin.y + j * cellSize - 0.5f);
+
+                mesh.vertices.push_back(normal.x);
+                mesh.vertices.push_back(normal.y);
+                mesh.vertices.push_back(normal.z);
+
+                mesh.vertices.push_back(layers[i * vertsPerSide + j]);
+            }
+        }
+
+        for (int i = 0; i < FAR_TERRAIN_GRID; ++i) {
+            for (int j = 0; j < FAR_TERRAIN_GRID; ++j) {
+                glm::ivec2 cellMin = origin + glm::ivec2(i, j) * cellSize;
+                glm::ivec2 cellMax = cellMin + glm::ivec2(cellSize);
+
+                bool insideChunks = cellMin.x >= innerMin.x && cellMax.x <= innerMax.x && cellMin.y >= innerMin.y && cellMax.y <= innerMax.y;
+                bool insideRing = cellMin.x >= ringInnerMin.x && cellMax.x <= ringInnerMax.x && cellMin.y >= ringInnerMin.y && cellMax.y <= ringInnerMax.y;
+                if (insideChunks || insideRing) continue;
+
+                unsigned int v00 = baseVertex + i * vertsPerSide + j;
+                unsigned int v01 = v00 + 1;
+                unsigned int v10 = v00 + vertsPerSide;
+                unsigned int v11 = v10 + 1;
+
+                // Counter clockwise seen from above
+                mesh.indices.push_back(v00);
+                mesh.indices.push_back(v01);
+                mesh.indices.push_back(v10);
+
+                mesh.indices.push_back(v10);
+                mesh.indices.push_back(v01);
+                mesh.indices.push_back(v11);
+            }
+        }
+    }
+
+    return mesh;
+}
+
+void FarTerrain::render(Shader& ourShader) {
+    if (drawCount == 0) return;
+
+    ourShader.setMatrix("model", glm::mat4(1.0f));
+    ourShader.setFloat("opacity", 1.0f);
+
+    glBindVertexArray(VAO);
+    glDrawElements(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, 0);
+    ++Stats::drawCalls;
+}
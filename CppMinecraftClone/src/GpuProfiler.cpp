@@ -0,0 +1,97 @@
+#include "headerfiles/GpuProfiler.hpp"
+#include "headerfiles/Profiler.hpp"
+
+#include <glad/glad.h>
+
+namespace GpuProfiler {
+    namespace {
+        const char* passNames[PASS_COUNT] = {
+            "GPU FarTerrain",
+            "GPU SolidChunks",
+            "GPU TransparentChunks",
+            "GPU Entities",
+            "GPU Highlight",
+            "GPU Hud"
+        };
+
+        struct PassQueries {
+            unsigned int queries[GPU_TIMER_FRAMES] = {};
+            bool issued[GPU_TIMER_FRAMES] = {};
+            uint64_t cpuStartNs[GPU_TIMER_FRAMES] = {};
+        };
+
+        PassQueries passQueries[PASS_COUNT];
+        float passTimes[PASS_COUNT] = {};
+
+        int frameIndex = 0;
+        bool initialized = false;
+    }
+
+    void init() {
+        for (PassQueries& pass : passQueries) {
+            glGenQueries(GPU_TIMER_FRAMES, pass.queries);
+        }
+        initialized = true;
+    }
+
+    void shutdown() {
+        if (!initialized) return;
+
+        for (PassQueries& pass : passQueries) {
+            glDeleteQueries(GPU_TIMER_FRAMES, pass.queries);
+        }
+        initialized = false;
+    }
+
+    void beginFrame() {
+        if (!initialized) return;
+
+        frameIndex = (frameIndex + 1) % GPU_TIMER_FRAMES;
+
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            PassQueries& queries = passQueries[pass];
+            if (!queries.issued[frameIndex]) continue;
+            queries.issued[frameIndex] = false;
+
+            // Still in flight after GPU_TIMER_FRAMES frames, drop it rather than wait
+            GLuint available = 0;
+            glGetQueryObjectuiv(queries.queries[frameIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) continue;
+
+            GLuint64 elapsedNs = 0;
+            glGetQueryObjectui64v(queries.queries[frameIndex], GL_QUERY_RESULT, &elapsedNs);
+
+            passTimes[pass] = elapsedNs / 1000000.0f;
+            // The GPU ran the pass some time after submission, the trace places it at submission
+            if (Profiler::isEnabled()) {
+                Profiler::recordGpu(passNames[pass], queries.cpuStartNs[frameIndex], elapsedNs);
+            }
+        }
+    }
+
+    float getPassTime(Pass pass) {
+        return passTimes[pass];
+    }
+
+    const char* getPassName(Pass pass) {
+        return passNames[pass];
+    }
+
+    Scope::Scope(Pass pass) :
+        pass(pass),
+        active(initialized)
+    {
+        if (!active) return;
+
+        PassQueries& queries = passQueries[pass];
+        queries.cpuStartNs[frameIndex] = Profiler::now();
+        glBeginQuery(GL_TIME_ELAPSED, queries.queries[frameIndex]);
+    }
+
+    Scope::~Scope() {
+        if (!active) return;
+
+        glEndQuery(GL_TIME_ELAPSED);
+        passQueries[pass].issued[frameIndex] = true;
+    }
+}
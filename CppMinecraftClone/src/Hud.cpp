@@ -0,0 +1,118 @@
+#include "headerfiles/Hud.hpp"
+#include "headerfiles/Camera.hpp"
+#include "headerfiles/UVHelper.hpp"
+#include "headerfiles/Stats.hpp"
+
+#include <glad/glad.h>
+
+namespace {
+    enum QuadKind {
+        SOLID,
+        TEXTURED,
+        OUTLINE
+    };
+
+    constexpr int HOTBAR_SLOTS = 9;
+    constexpr int HOTBAR_ICONS = 6;
+    // Slot frames, icons and the two crosshair bars
+    constexpr int MAX_INSTANCES = HOTBAR_SLOTS + HOTBAR_ICONS + 2;
+    constexpr int FLOATS_PER_INSTANCE = 12;
+
+    const float SLOT_LEFT = -0.3f;
+    const float SLOT_WIDTH = 0.6f / HOTBAR_SLOTS;
+
+    void addQuad(std::vector<float>& out, float x0, float y0, float x1, float y1,
+        const glm::vec4& color, QuadKind kind, bool selected, int layer = 0) {
+        const float instance[FLOATS_PER_INSTANCE] = {
+            x0, y0, x1, y1,
+            color.r, color.g, color.b, color.a,
+            static_cast<float>(kind), selected ? 1.0f : 0.0f, static_cast<float>(layer), 0.0f
+        };
+        out.insert(out.end(), instance, instance + FLOATS_PER_INSTANCE);
+    }
+}
+
+Hud::Hud(AssetManager& assets) :
+    shader(assets.loadShader("src/shaders/vs/hud.vs", "src/shaders/fs/hud.fs"))
+{
+    shader->onLoad = [](Shader& program) {
+        program.use();
+        program.setInt("textureVal", 0);
+        program.setVec2("pixelSize", glm::vec2(2.0f / SCR_WIDTH, 2.0f / SCR_HEIGHT));
+    };
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    // Sized once for the whole HUD, later updates only overwrite it
+    glBufferData(GL_ARRAY_BUFFER, MAX_INSTANCES * FLOATS_PER_INSTANCE * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+
+    const GLsizei stride = FLOATS_PER_INSTANCE * sizeof(float);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    for (unsigned int attribute = 0; attribute < 3; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindVertexArray(0);
+}
+
+Hud::~Hud() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &instanceVBO);
+}
+
+void Hud::buildInstances(int selectedSlot) {
+    instances.clear();
+
+    // Slot frames, the selected one last so its thicker frame covers its neighbors
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < HOTBAR_SLOTS; ++i) {
+            bool selected = i == selectedSlot;
+            if (selected != (pass == 1)) continue;
+
+            addQuad(instances, SLOT_LEFT + SLOT_WIDTH * i, -1.0f, SLOT_LEFT + SLOT_WIDTH * (i + 1), -0.88f,
+                glm::vec4(1.0f), OUTLINE, selected);
+        }
+    }
+
+    // Block icons
+    for (int i = 0; i < HOTBAR_ICONS; ++i) {
+        int layer = UVHelper::getTileLayer(static_cast<UVHelper::BlockType>(i + 1), 0);
+
+        float x0 = -0.29f + SLOT_WIDTH * i;
+        float x1 = -0.29f + SLOT_WIDTH * (i + 1) - 0.02f;
+        addQuad(instances, x0, -0.98f, x1, -0.90f, glm::vec4(1.0f), TEXTURED, false, layer);
+    }
+
+    // Crosshair, two pixels thick
+    const float halfWidth = 1080.0f / 100000.0f;
+    const float halfHeight = 1920.0f / 100000.0f;
+    const float thicknessX = 1.0f / SCR_WIDTH * 2.0f;
+    const float thicknessY = 1.0f / SCR_HEIGHT * 2.0f;
+    addQuad(instances, -halfWidth, -thicknessY, halfWidth, thicknessY, glm::vec4(1.0f), SOLID, false);
+    addQuad(instances, -thicknessX, -halfHeight, thicknessX, halfHeight, glm::vec4(1.0f), SOLID, false);
+
+    instanceCount = static_cast<int>(instances.size() / FLOATS_PER_INSTANCE);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(float), instances.data());
+    Stats::bytesUploaded += instances.size() * sizeof(float);
+
+    builtSlot = selectedSlot;
+}
+
+void Hud::render(int selectedSlot) {
+    if (selectedSlot != builtSlot) {
+        buildInstances(selectedSlot);
+    }
+
+    shader->get().use();
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+    glBindVertexArray(0);
+    ++Stats::drawCalls;
+}
@@ -0,0 +1,170 @@
+#include "headerfiles/Input.hpp"
+
+#include <iostream>
+
+namespace {
+    const int TRACKED_KEYS[] = {
+        GLFW_KEY_ESCAPE, GLFW_KEY_F3, GLFW_KEY_F9,
+        GLFW_KEY_1, GLFW_KEY_2, GLFW_KEY_3, GLFW_KEY_4, GLFW_KEY_5,
+        GLFW_KEY_6, GLFW_KEY_7, GLFW_KEY_8, GLFW_KEY_9,
+        GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D,
+        GLFW_KEY_SPACE, GLFW_KEY_LEFT_SHIFT, GLFW_KEY_LEFT_CONTROL,
+        // Appended so older recordings keep their bit layout
+        GLFW_KEY_Q, GLFW_KEY_F,
+        GLFW_KEY_LEFT_ALT, GLFW_KEY_G, GLFW_KEY_R, GLFW_KEY_C, GLFW_KEY_V,
+        GLFW_KEY_F8
+    };
+    constexpr int TRACKED_KEY_COUNT = sizeof(TRACKED_KEYS) / sizeof(TRACKED_KEYS[0]);
+    static_assert(TRACKED_KEY_COUNT <= 32, "InputFrame::keys holds one bit per tracked key");
+
+    const char RECORDING_MAGIC[4] = { 'M', 'C', 'I', 'R' };
+    constexpr uint32_t RECORDING_VERSION = 1;
+
+    int keyBit(int key) {
+        for (int i = 0; i < TRACKED_KEY_COUNT; ++i) {
+            if (TRACKED_KEYS[i] == key) return i;
+        }
+        return -1;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+bool InputFrame::isKeyDown(int key) const {
+    int bit = keyBit(key);
+    return bit >= 0 && (keys & (1u << bit)) != 0;
+}
+
+InputSource::~InputSource() {
+    if (recordFile.is_open()) {
+        recordFile.close();
+    }
+}
+
+void InputSource::onCursor(double x, double y) {
+    if (replaying) return;
+
+    pending.cursorMoved = true;
+    pending.cursorX = x;
+    pending.cursorY = y;
+}
+
+void InputSource::onScroll(double yoffset) {
+    if (replaying) return;
+
+    pending.scroll += yoffset;
+}
+
+void InputSource::onMouseButton(int button, int action) {
+    if (replaying || action != GLFW_PRESS) return;
+
+    if (button == GLFW_MOUSE_BUTTON_LEFT) pending.leftClick = true;
+    if (button == GLFW_MOUSE_BUTTON_RIGHT) pending.rightClick = true;
+}
+
+bool InputSource::startRecording(const std::string& path) {
+    recordFile.open(path, std::ios::binary);
+    if (!recordFile) {
+        std::cout << "ERROR::INPUT::COULD_NOT_OPEN_RECORDING: " << path << std::endl;
+        return false;
+    }
+
+    recordFile.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    writeValue(recordFile, RECORDING_VERSION);
+    return true;
+}
+
+bool InputSource::startReplay(const std::string& path) {
+    replayFile.open(path, std::ios::binary);
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    if (!replayFile || !replayFile.read(magic, sizeof(magic)) || !readValue(replayFile, version) ||
+        std::string(magic, 4) != std::string(RECORDING_MAGIC, 4) || version != RECORDING_VERSION) {
+        std::cout << "ERROR::INPUT::INVALID_RECORDING: " << path << std::endl;
+        replayFile.close();
+        return false;
+    }
+
+    replaying = true;
+    finished = false;
+    return true;
+}
+
+bool InputSource::isReplaying() const {
+    return replaying;
+}
+
+bool InputSource::replayFinished() const {
+    return finished;
+}
+
+void InputSource::writeFrame(const InputFrame& frame) {
+    writeValue(recordFile, frame.deltaTime);
+    writeValue(recordFile, frame.keys);
+    writeValue(recordFile, static_cast<uint8_t>(frame.cursorMoved | frame.leftClick << 1 | frame.rightClick << 2));
+    writeValue(recordFile, frame.cursorX);
+    writeValue(recordFile, frame.cursorY);
+    writeValue(recordFile, frame.scroll);
+}
+
+bool InputSource::readFrame(InputFrame& frame) {
+    uint8_t flags = 0;
+    if (!readValue(replayFile, frame.deltaTime) || !readValue(replayFile, frame.keys) || !readValue(replayFile, flags) ||
+        !readValue(replayFile, frame.cursorX) || !readValue(replayFile, frame.cursorY) || !readValue(replayFile, frame.scroll)) {
+        return false;
+    }
+
+    frame.cursorMoved = (flags & 1) != 0;
+    frame.leftClick = (flags & 2) != 0;
+    frame.rightClick = (flags & 4) != 0;
+    return true;
+}
+
+InputFrame InputSource::nextFrame(GLFWwindow* window, float deltaTime, float fixedDeltaTime) {
+    InputFrame frame;
+
+    if (replaying) {
+        if (!finished && !readFrame(frame)) {
+            finished = true;
+            std::cout << "Input replay finished" << std::endl;
+        }
+        if (finished) {
+            frame = InputFrame();
+            frame.deltaTime = deltaTime;
+        }
+
+        // Escape still works so a replay can be cut short
+        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+            frame.keys |= 1u << keyBit(GLFW_KEY_ESCAPE);
+        }
+    }
+    else {
+        frame = pending;
+        pending = InputFrame();
+
+        frame.deltaTime = deltaTime;
+        frame.keys = 0;
+        for (int i = 0; i < TRACKED_KEY_COUNT; ++i) {
+            if (glfwGetKey(window, TRACKED_KEYS[i]) == GLFW_PRESS) frame.keys |= 1u << i;
+        }
+    }
+
+    if (fixedDeltaTime > 0.0f) {
+        frame.deltaTime = fixedDeltaTime;
+    }
+
+    if (recordFile.is_open()) {
+        writeFrame(frame);
+    }
+
+    return frame;
+}
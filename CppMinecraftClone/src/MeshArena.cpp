@@ -0,0 +1,76 @@
+#include "headerfiles/MeshArena.hpp"
+#include "headerfiles/Constants.hpp"
+#include "headerfiles/Stats.hpp"
+
+#include <mutex>
+
+namespace {
+    // Arenas kept for reuse. Enough for the mesh jobs of a busy frame, the burst of jobs while
+    // the world first meshes frees everything past it
+    const size_t MAX_POOLED_ARENAS = 16;
+
+    // Every face is 6 vertices with one index each
+    const size_t FACE_FLOATS = 6 * TERRAIN_VERTEX_FLOATS;
+    const size_t FACE_INDICES = 6;
+
+    std::mutex poolMutex;
+    std::vector<std::unique_ptr<MeshArena>> pool;
+}
+
+void MeshArena::reserveFaces(size_t solidFaces, size_t transparentFaces) {
+    solidVertices.reserve(solidFaces * FACE_FLOATS);
+    solidIndices.reserve(solidFaces * FACE_INDICES);
+    transparentVertices.reserve(transparentFaces * FACE_FLOATS);
+    transparentIndices.reserve(transparentFaces * FACE_INDICES);
+}
+
+void MeshArena::clear() {
+    solidVertices.clear();
+    solidIndices.clear();
+    transparentVertices.clear();
+    transparentIndices.clear();
+    lodCells.clear();
+    lodColumnTops.clear();
+}
+
+size_t MeshArena::getByteSize() const {
+    return (solidVertices.capacity() + transparentVertices.capacity()) * sizeof(float) +
+        (solidIndices.capacity() + transparentIndices.capacity()) * sizeof(unsigned int) +
+        lodCells.capacity() * sizeof(UVHelper::BlockType) + lodColumnTops.capacity() * sizeof(int);
+}
+
+namespace MeshArenas {
+    std::unique_ptr<MeshArena> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!pool.empty()) {
+                std::unique_ptr<MeshArena> arena = std::move(pool.back());
+                pool.pop_back();
+                return arena;
+            }
+        }
+        return std::unique_ptr<MeshArena>(new MeshArena());
+    }
+
+    void release(std::unique_ptr<MeshArena> arena) {
+        if (!arena) return;
+
+        size_t bytes = arena->getByteSize();
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (pool.size() < MAX_POOLED_ARENAS) {
+                Stats::meshCpuBytes += static_cast<int64_t>(bytes) - static_cast<int64_t>(arena->countedBytes);
+                arena->countedBytes = bytes;
+                arena->clear();
+                pool.push_back(std::move(arena));
+                return;
+            }
+        }
+        Stats::meshCpuBytes -= static_cast<int64_t>(arena->countedBytes);
+    }
+
+    int getPooledCount() {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        return static_cast<int>(pool.size());
+    }
+}
@@ -0,0 +1,63 @@
+#include "headerfiles/Noise.hpp"
+
+#define STB_PERLIN_IMPLEMENTATION
+#include "includes/stb_perlin.h"
+
+namespace Noise {
+    namespace {
+        struct ChannelState {
+            uint64_t hash;
+            int permutation;
+            // stb's lattice repeats every 256 units, so offsets below that cover every shift
+            float offsetX, offsetY, offsetZ;
+        };
+
+        uint64_t worldSeed = 0;
+        ChannelState channels[CHANNEL_COUNT];
+
+        // splitmix64 finalizer, spreads every input bit over the whole result
+        uint64_t mix(uint64_t value) {
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        float offsetFrom(uint64_t bits) {
+            return static_cast<float>(bits & 0xFFFF) / 256.0f;
+        }
+
+        struct SeedInitializer {
+            SeedInitializer() { setSeed(0); }
+        };
+        SeedInitializer seedInitializer;
+    }
+
+    void setSeed(uint64_t seed) {
+        worldSeed = seed;
+        for (int channel = 0; channel < CHANNEL_COUNT; ++channel) {
+            uint64_t hash = mix(seed ^ mix(static_cast<uint64_t>(channel)));
+
+            ChannelState& state = channels[channel];
+            state.hash = hash;
+            state.permutation = static_cast<int>(hash & 0xFF);
+            state.offsetX = offsetFrom(hash >> 8);
+            state.offsetY = offsetFrom(hash >> 24);
+            state.offsetZ = offsetFrom(hash >> 40);
+        }
+    }
+
+    uint64_t getSeed() {
+        return worldSeed;
+    }
+
+    float perlin(Channel channel, float x, float y, float z) {
+        const ChannelState& state = channels[channel];
+        return stb_perlin_noise3_seed(x + state.offsetX, y + state.offsetY, z + state.offsetZ, 0, 0, 0, state.permutation);
+    }
+
+    uint32_t chunkSeed(Channel channel, int chunkX, int chunkZ) {
+        uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkZ);
+        return static_cast<uint32_t>(mix(channels[channel].hash ^ position));
+    }
+}
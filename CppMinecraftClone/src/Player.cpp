@@ -4,7 +4,7 @@
 Player::Player() :
 	physicalState(true),
 	currentInventorySlot(0),
-	renderDistance(4),
+	renderDistance(16),
 	heldBlock(UVHelper::BlockType::GRASS)
 {
     gamemodeDescription();
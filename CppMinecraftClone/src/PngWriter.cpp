@@ -0,0 +1,120 @@
+#include "headerfiles/PngWriter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    uint32_t crcTable[256];
+    bool crcTableReady = false;
+
+    uint32_t crc32(const unsigned char* data, size_t length, uint32_t crc = 0) {
+        if (!crcTableReady) {
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                crcTable[n] = c;
+            }
+            crcTableReady = true;
+        }
+
+        crc = ~crc;
+        for (size_t i = 0; i < length; ++i) {
+            crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    uint32_t adler32(const std::vector<unsigned char>& data) {
+        uint32_t a = 1, b = 0;
+        for (unsigned char byte : data) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        return (b << 16) | a;
+    }
+
+    void appendBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void writeChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data) {
+        std::vector<unsigned char> chunk;
+        chunk.reserve(data.size() + 12);
+        appendBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        // The CRC covers the type and the data but not the length
+        appendBigEndian(chunk, crc32(chunk.data() + 4, chunk.size() - 4));
+
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+}
+
+namespace PngWriter {
+    bool writeRgb(const std::string& path, int width, int height, const unsigned char* pixels, bool flipVertically) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cout << "ERROR::PNG::COULD_NOT_OPEN_FILE: " << path << std::endl;
+            return false;
+        }
+
+        const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        std::vector<unsigned char> header;
+        appendBigEndian(header, static_cast<uint32_t>(width));
+        appendBigEndian(header, static_cast<uint32_t>(height));
+        header.push_back(8); // bit depth
+        header.push_back(2); // truecolor
+        header.push_back(0); // deflate
+        header.push_back(0); // adaptive filtering
+        header.push_back(0); // no interlace
+        writeChunk(file, "IHDR", header);
+
+        // Every scanline starts with filter type 0
+        const size_t rowBytes = static_cast<size_t>(width) * 3;
+        std::vector<unsigned char> raw;
+        raw.reserve((rowBytes + 1) * height);
+        for (int y = 0; y < height; ++y) {
+            int sourceRow = flipVertically ? height - 1 - y : y;
+            const unsigned char* row = pixels + sourceRow * rowBytes;
+            raw.push_back(0);
+            raw.insert(raw.end(), row, row + rowBytes);
+        }
+
+        const size_t maxBlock = 65535;
+        std::vector<unsigned char> compressed;
+        compressed.reserve(raw.size() + raw.size() / maxBlock * 5 + 16);
+        compressed.push_back(0x78);
+        compressed.push_back(0x01);
+
+        size_t offset = 0;
+        do {
+            size_t length = std::min(maxBlock, raw.size() - offset);
+            bool last = offset + length == raw.size();
+
+            compressed.push_back(last ? 1 : 0);
+            compressed.push_back(static_cast<unsigned char>(length & 0xFF));
+            compressed.push_back(static_cast<unsigned char>(length >> 8));
+            compressed.push_back(static_cast<unsigned char>(~length & 0xFF));
+            compressed.push_back(static_cast<unsigned char>((~length >> 8) & 0xFF));
+            compressed.insert(compressed.end(), raw.begin() + offset, raw.begin() + offset + length);
+
+            offset += length;
+        } while (offset < raw.size());
+
+        appendBigEndian(compressed, adler32(raw));
+        writeChunk(file, "IDAT", compressed);
+        writeChunk(file, "IEND", std::vector<unsigned char>());
+
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,137 @@
+#include "headerfiles/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Profiler {
+    std::atomic<bool> enabled{ false };
+
+    namespace {
+        struct Event {
+            const char* name;
+            uint64_t startNs;
+            uint64_t durationNs;
+            uint32_t threadId;
+        };
+
+        // Sequence is the write index + 1 of the event in the slot, 0 while it is being
+        // written. The dump skips slots whose sequence doesn't match what it expects
+        struct Slot {
+            std::atomic<uint64_t> sequence{ 0 };
+            Event event;
+        };
+
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        std::vector<Slot> ring(RING_CAPACITY);
+        std::atomic<uint64_t> writeIndex{ 0 };
+
+        // Far above any real thread id
+        constexpr uint32_t GPU_TRACK_ID = 1000000;
+
+        std::atomic<uint32_t> nextThreadId{ 0 };
+        // Only naming threads and dumping take it
+        std::mutex namesMutex;
+        std::map<uint32_t, std::string> threadNames;
+
+        thread_local uint32_t threadId = nextThreadId++;
+
+        void push(const char* name, uint64_t startNs, uint64_t durationNs, uint32_t id) {
+            uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+            Slot& slot = ring[index % RING_CAPACITY];
+
+            slot.sequence.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.event = { name, startNs, durationNs, id };
+            slot.sequence.store(index + 1, std::memory_order_release);
+        }
+    }
+
+    void setEnabled(bool enable) {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+    }
+
+    uint32_t currentThreadId() {
+        return threadId;
+    }
+
+    void setThreadName(const char* name) {
+        std::lock_guard<std::mutex> lock(namesMutex);
+        threadNames[threadId] = name;
+    }
+
+    void record(const char* name, uint64_t startNs, uint64_t durationNs) {
+        push(name, startNs, durationNs, threadId);
+    }
+
+    void recordGpu(const char* name, uint64_t startNs, uint64_t durationNs) {
+        push(name, startNs, durationNs, GPU_TRACK_ID);
+    }
+
+    bool dumpChromeTrace(const char* path) {
+        std::vector<Event> events;
+        std::map<uint32_t, std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(namesMutex);
+            names = threadNames;
+        }
+        names[GPU_TRACK_ID] = "GPU";
+
+        // Threads keep recording while this copies, slots that are mid write or already
+        // overwritten by a newer zone are left out
+        uint64_t end = writeIndex.load(std::memory_order_acquire);
+        uint64_t count = std::min<uint64_t>(end, RING_CAPACITY);
+        events.reserve(count);
+        for (uint64_t i = end - count; i < end; ++i) {
+            Slot& slot = ring[i % RING_CAPACITY];
+            if (slot.sequence.load(std::memory_order_acquire) != i + 1) continue;
+            Event event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != i + 1) continue;
+            events.push_back(event);
+        }
+
+        std::ofstream out(path);
+        if (!out) {
+            std::cout << "ERROR::PROFILER::COULD_NOT_OPEN " << path << std::endl;
+            return false;
+        }
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+
+        for (const std::pair<const uint32_t, std::string>& thread : names) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+                << ",\"args\":{\"name\":\"" << thread.second << "\"}}";
+            first = false;
+        }
+
+        for (const Event& event : events) {
+            // Trace timestamps are in microseconds
+            out << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+                << ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+            first = false;
+        }
+
+        out << "\n]}\n";
+
+        std::cout << "Wrote " << events.size() << " profiler zones to " << path << std::endl;
+        return true;
+    }
+}
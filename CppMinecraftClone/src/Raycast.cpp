@@ -1,6 +1,7 @@
 #include "headerfiles/Raycast.hpp"
 #include "headerfiles/Chunk.hpp"
 #include "headerfiles/World.hpp"
+#include "headerfiles/Profiler.hpp"
 
 
 RaycastResult currentRayResult = { false, {}, {} };
@@ -22,6 +23,8 @@ bool isBlockSolid(glm::ivec3 pos) {
 static inline int getSign(int v) { return (v > 0) - (v < 0); }
 
 void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+    PROFILE_ZONE("raycast");
+
     glm::vec3 rayDir = glm::normalize(direction);
     glm::vec3 resPos;
 
@@ -1,12 +1,143 @@
 #include "headerfiles/Shader.hpp"
+#include "headerfiles/Profiler.hpp"
 
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
-    std::string vertexCode;
-    std::string fragmentCode;
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    // Program binaries are core in 4.1 and parallel compiles are an extension, glad only
+    // loads 3.3 so these come from GLFW
+    typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+    typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+    typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+    typedef void (APIENTRYP MaxShaderCompilerThreadsProc)(GLuint count);
+
+    const GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+    const GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+    const GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+    const char* CACHE_DIRECTORY = "shader_cache";
+
+    GetProgramBinaryProc getProgramBinary = nullptr;
+    ProgramBinaryProc programBinary = nullptr;
+    ProgramParameteriProc programParameteri = nullptr;
+
+    bool initialized = false;
+    bool binaryCacheSupported = false;
+    // Mixed into every cache key so a driver update never loads a stale binary
+    std::string driverId;
+
+    void initShaderCache() {
+        if (initialized) return;
+        initialized = true;
+
+        getProgramBinary = (GetProgramBinaryProc)glfwGetProcAddress("glGetProgramBinary");
+        programBinary = (ProgramBinaryProc)glfwGetProcAddress("glProgramBinary");
+        programParameteri = (ProgramParameteriProc)glfwGetProcAddress("glProgramParameteri");
+
+        int formats = 0;
+        if (getProgramBinary && programBinary && programParameteri) {
+            glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+        }
+        binaryCacheSupported = formats > 0;
+
+        if (binaryCacheSupported) {
+#if defined(_WIN32)
+            _mkdir(CACHE_DIRECTORY);
+#else
+            mkdir(CACHE_DIRECTORY, 0755);
+#endif
+        }
+
+        driverId = std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + "|" +
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER)) + "|" +
+            reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+        // Lets the driver compile on its own threads, status queries are what block
+        MaxShaderCompilerThreadsProc maxCompilerThreads = nullptr;
+        if (glfwExtensionSupported("GL_KHR_parallel_shader_compile")) {
+            maxCompilerThreads = (MaxShaderCompilerThreadsProc)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        }
+        else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile")) {
+            maxCompilerThreads = (MaxShaderCompilerThreadsProc)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+        }
+        if (maxCompilerThreads) {
+            maxCompilerThreads(0xFFFFFFFF);
+        }
+    }
+
+    uint64_t hashString(uint64_t hash, const std::string& text) {
+        // FNV-1a
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string cachePathFor(const std::string& vertexCode, const std::string& fragmentCode) {
+        uint64_t hash = 14695981039346656037ull;
+        hash = hashString(hash, vertexCode);
+        hash = hashString(hash, std::string(1, '\0'));
+        hash = hashString(hash, fragmentCode);
+        hash = hashString(hash, driverId);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+        return std::string(CACHE_DIRECTORY) + "/" + name;
+    }
+
+    // The file holds the binary format followed by the program binary
+    bool loadCachedProgram(unsigned int program, const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+
+        uint32_t format = 0;
+        if (!file.read(reinterpret_cast<char*>(&format), sizeof(format))) return false;
+        std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (binary.empty()) return false;
+
+        programBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        // A driver can reject a binary it wrote itself, callers compile from source then
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        return success != 0;
+    }
+
+    void saveCachedProgram(unsigned int program, const std::string& path) {
+        int length = 0;
+        glGetProgramiv(program, PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        getProgramBinary(program, length, nullptr, &format, binary.data());
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cout << "ERROR::SHADER::CACHE_NOT_WRITTEN: " << path << std::endl;
+            return;
+        }
+        uint32_t storedFormat = format;
+        file.write(reinterpret_cast<const char*>(&storedFormat), sizeof(storedFormat));
+        file.write(binary.data(), binary.size());
+    }
+}
+
+bool Shader::readSource(const std::string& vertexPath, const std::string& fragmentPath, ShaderSource& source) {
     std::ifstream vShaderFile;
     std::ifstream fShaderFile;
 
@@ -24,21 +155,75 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         vShaderFile.close();
         fShaderFile.close();
 
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        source.vertex = vShaderStream.str();
+        source.fragment = fShaderStream.str();
     }
     catch (std::ifstream::failure& e) {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ\n";
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << vertexPath << ", " << fragmentPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+    ShaderSource source;
+    if (!readSource(vertexPath, fragmentPath, source)) {
+        // An empty program that never links, isLinked reports the failure
+        ID = glCreateProgram();
+        return;
+    }
+    build(source);
+}
+
+Shader::Shader(const ShaderSource& source) {
+    build(source);
+}
+
+void Shader::build(const ShaderSource& source) {
+    PROFILE_ZONE("Shader::build");
+
+    const std::string& vertexCode = source.vertex;
+    const std::string& fragmentCode = source.fragment;
+
+    initShaderCache();
+
+    ID = glCreateProgram();
+
+    if (binaryCacheSupported) {
+        cachePath = cachePathFor(vertexCode, fragmentCode);
+        if (loadCachedProgram(ID, cachePath)) {
+            linked = true;
+            return;
+        }
+
+        programParameteri(ID, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
 
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    // Compile vertex shader
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    vertexShader = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertexShader, 1, &vShaderCode, nullptr);
     glCompileShader(vertexShader);
 
+    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
+    glCompileShader(fragmentShader);
+
+    glAttachShader(ID, vertexShader);
+    glAttachShader(ID, fragmentShader);
+    glLinkProgram(ID);
+
+    // Status queries wait for the compiler, they're left for the first use
+    linkPending = true;
+}
+
+void Shader::finishLink() {
+    if (!linkPending) return;
+    linkPending = false;
+
+    PROFILE_ZONE("Shader::finishLink");
+
     int success;
     char infoLog[512];
     glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
@@ -47,41 +232,48 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
     }
 
-    // Compile fragment shader
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
-    glCompileShader(fragmentShader);
-
     glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
     if (!success) {
         glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
         std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
     }
 
-    // Link shaders
-    ID = glCreateProgram();
-    glAttachShader(ID, vertexShader);
-    glAttachShader(ID, fragmentShader);
-    glLinkProgram(ID);
-
     glGetProgramiv(ID, GL_LINK_STATUS, &success);
     if (!success) {
         glGetProgramInfoLog(ID, 512, nullptr, infoLog);
         std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
     }
+    else {
+        linked = true;
+        if (!cachePath.empty()) {
+            saveCachedProgram(ID, cachePath);
+        }
+    }
 
+    glDetachShader(ID, vertexShader);
+    glDetachShader(ID, fragmentShader);
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    vertexShader = 0;
+    fragmentShader = 0;
 }
 
 Shader::~Shader() {
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
     glDeleteProgram(ID);
 }
 
-void Shader::use() const {
+void Shader::use() {
+    finishLink();
     glUseProgram(ID);
 }
 
+bool Shader::isLinked() {
+    finishLink();
+    return linked;
+}
+
 void Shader::setBool(const std::string& name, bool value) const {
     glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
 }
@@ -94,6 +286,10 @@ void Shader::setFloat(const std::string& name, float value) const {
     glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
 }
 
+void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
+    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(value));
+}
+
 void Shader::setVec3(const std::string& name, glm::vec3& value) const {
     glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(value));
 }
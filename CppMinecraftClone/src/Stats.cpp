@@ -0,0 +1,89 @@
+#include "headerfiles/Stats.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+namespace Stats {
+    std::atomic<int> chunksLoaded{ 0 };
+    std::atomic<int> chunksMeshed{ 0 };
+    std::atomic<int> chunksCompressed{ 0 };
+    std::atomic<int> meshJobsInFlight{ 0 };
+
+    std::atomic<int> entityCount{ 0 };
+    std::atomic<int64_t> entityUpdateNs{ 0 };
+
+    std::atomic<int64_t> gpuVertices{ 0 };
+    std::atomic<int64_t> gpuIndices{ 0 };
+
+    std::atomic<int64_t> voxelBytes{ 0 };
+    std::atomic<int64_t> meshCpuBytes{ 0 };
+    std::atomic<int64_t> meshGpuBytes{ 0 };
+    std::atomic<int64_t> farTerrainBytes{ 0 };
+
+    std::atomic<int> chunksDrawn{ 0 };
+    std::atomic<int> chunksCulled{ 0 };
+    std::atomic<int> drawCalls{ 0 };
+    std::atomic<int64_t> bytesUploaded{ 0 };
+
+    namespace {
+        constexpr size_t FRAME_HISTORY = 256;
+
+        FrameCounters previousFrame;
+        std::vector<float> frameTimes(FRAME_HISTORY, 0.0f);
+        size_t frameCount = 0;
+    }
+
+    void endFrame(float frameSeconds) {
+        frameTimes[frameCount % FRAME_HISTORY] = frameSeconds * 1000.0f;
+        ++frameCount;
+
+        previousFrame.chunksDrawn = chunksDrawn.exchange(0);
+        previousFrame.chunksCulled = chunksCulled.exchange(0);
+        previousFrame.drawCalls = drawCalls.exchange(0);
+        previousFrame.bytesUploaded = bytesUploaded.exchange(0);
+    }
+
+    const FrameCounters& lastFrame() {
+        return previousFrame;
+    }
+
+    float frameTimePercentile(float percentile) {
+        size_t count = std::min(frameCount, FRAME_HISTORY);
+        if (count == 0) return 0.0f;
+
+        std::vector<float> sorted(frameTimes.begin(), frameTimes.begin() + count);
+        size_t index = std::min(count - 1, static_cast<size_t>(percentile / 100.0f * count));
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+
+    size_t processResidentBytes() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.WorkingSetSize;
+        }
+        return 0;
+#elif defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        size_t totalPages = 0, residentPages = 0;
+        if (statm >> totalPages >> residentPages) {
+            return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+        return 0;
+#else
+        return 0;
+#endif
+    }
+}
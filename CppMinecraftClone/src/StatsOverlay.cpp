@@ -0,0 +1,108 @@
+#include "headerfiles/StatsOverlay.hpp"
+#include "headerfiles/Biomes.hpp"
+#include "headerfiles/Stats.hpp"
+#include "headerfiles/GpuProfiler.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/TerrainGenerator.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace {
+    std::string formatLine(const char* pattern, ...) {
+        char buffer[256];
+        va_list args;
+        va_start(args, pattern);
+        std::vsnprintf(buffer, sizeof(buffer), pattern, args);
+        va_end(args);
+        return buffer;
+    }
+
+    const char* PASS_LABELS[GpuProfiler::PASS_COUNT] = {
+        "FAR", "SOLID", "TRANSPARENT", "ENTITIES", "HIGHLIGHT", "HUD"
+    };
+
+    const char* STAGE_LABELS[TerrainGenerator::STAGE_COUNT] = {
+        "CLIMATE", "DENSITY", "SURFACE", "CARVERS", "ORES", "DECOR"
+    };
+
+    double toMegabytes(int64_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+void StatsOverlay::render(int screenWidth, int screenHeight) {
+    PROFILE_ZONE("StatsOverlay");
+
+    const Stats::FrameCounters& frame = Stats::lastFrame();
+    float p50 = Stats::frameTimePercentile(50.0f);
+
+    std::vector<std::string> lines;
+    lines.push_back(formatLine("FPS %.0f  FRAME MS  P50 %.2f  P95 %.2f  P99 %.2f  MAX %.2f",
+        p50 > 0.0f ? 1000.0f / p50 : 0.0f, p50, Stats::frameTimePercentile(95.0f),
+        Stats::frameTimePercentile(99.0f), Stats::frameTimePercentile(100.0f)));
+
+    std::string gpuLine = "GPU MS";
+    for (int pass = 0; pass < GpuProfiler::PASS_COUNT; ++pass) {
+        GpuProfiler::Pass gpuPass = static_cast<GpuProfiler::Pass>(pass);
+        gpuLine += formatLine("  %s %.2f", PASS_LABELS[pass], GpuProfiler::getPassTime(gpuPass));
+    }
+    lines.push_back(gpuLine);
+
+    lines.push_back(formatLine("CHUNKS  LOADED %d  MESHED %d  DRAWN %d  CULLED %d",
+        Stats::chunksLoaded.load(), Stats::chunksMeshed.load(), frame.chunksDrawn, frame.chunksCulled));
+    std::string generationLine = "GEN MS PER CHUNK";
+    for (int stage = 0; stage < TerrainGenerator::STAGE_COUNT; ++stage) {
+        TerrainGenerator::Stage generatorStage = static_cast<TerrainGenerator::Stage>(stage);
+        generationLine += formatLine("  %s %.2f", STAGE_LABELS[stage], TerrainGenerator::getStageTime(generatorStage));
+    }
+    lines.push_back(generationLine);
+
+    int64_t climateHits = Biomes::getCacheHits();
+    int64_t climateLookups = climateHits + Biomes::getCacheMisses();
+    lines.push_back(formatLine("CLIMATE CACHE %d REGIONS  HITS %.1f%%",
+        Biomes::getCachedRegions(), climateLookups > 0 ? 100.0 * climateHits / climateLookups : 0.0));
+    lines.push_back(formatLine("ENTITIES %d  TICK %.2f MS",
+        Stats::entityCount.load(), Stats::entityUpdateNs.load() / 1.0e6));
+    lines.push_back(formatLine("GPU MESHES  VERTICES %lld  INDICES %lld",
+        static_cast<long long>(Stats::gpuVertices.load()), static_cast<long long>(Stats::gpuIndices.load())));
+    lines.push_back(formatLine("DRAW CALLS %d  MESH JOBS %d  UPLOADED %.1f KB",
+        frame.drawCalls, Stats::meshJobsInFlight.load(), frame.bytesUploaded / 1024.0));
+
+    int64_t voxels = Stats::voxelBytes.load();
+    int64_t meshCpu = Stats::meshCpuBytes.load();
+    int64_t meshGpu = Stats::meshGpuBytes.load();
+    int64_t farTerrain = Stats::farTerrainBytes.load();
+    int64_t resident = static_cast<int64_t>(Stats::processResidentBytes());
+    // Buffer memory lives in the driver, only part of it shows up in the process
+    int64_t other = std::max<int64_t>(0, resident - voxels - meshCpu);
+
+    lines.push_back(formatLine("MEMORY MB  RSS %.1f  VOXELS %.1f  MESH CPU %.1f  OTHER %.1f",
+        toMegabytes(resident), toMegabytes(voxels), toMegabytes(meshCpu), toMegabytes(other)));
+    lines.push_back(formatLine("CHUNK STORAGE  DENSE %d  COLUMN RUNS %d",
+        Stats::chunksLoaded.load() - Stats::chunksCompressed.load(), Stats::chunksCompressed.load()));
+    lines.push_back(formatLine("GPU BUFFERS MB  CHUNKS %.1f  FAR TERRAIN %.1f",
+        toMegabytes(meshGpu), toMegabytes(farTerrain)));
+
+    const float margin = 8.0f;
+    const float lineHeight = TextRenderer::lineHeight();
+    float panelWidth = 0.0f;
+    for (const std::string& line : lines) {
+        panelWidth = std::max(panelWidth, TextRenderer::textWidth(line));
+    }
+
+    text.begin(screenWidth, screenHeight);
+    text.addRect(0.0f, 0.0f, panelWidth + margin * 2.0f, lines.size() * lineHeight + margin * 2.0f, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+    for (size_t i = 0; i < lines.size(); ++i) {
+        text.addText(margin, margin + i * lineHeight, lines[i], glm::vec4(1.0f));
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    text.flush();
+    glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,432 @@
+#include "headerfiles/TerrainGenerator.hpp"
+#include "headerfiles/Noise.hpp"
+#include "headerfiles/Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace TerrainGenerator {
+    namespace {
+        const char* STAGE_NAMES[STAGE_COUNT] = {
+            "TerrainGenerator::climate",
+            "TerrainGenerator::density",
+            "TerrainGenerator::surface",
+            "TerrainGenerator::carvers",
+            "TerrainGenerator::ores",
+            "TerrainGenerator::decoration"
+        };
+
+        std::atomic<int64_t> stageNs[STAGE_COUNT];
+        std::atomic<int> chunksGenerated(0);
+
+        // How far 3D noise can push the surface up or down, in blocks
+        const float OVERHANG_STRENGTH = 6.0f;
+
+        // Caves follow the lines where two noise fields are both close to zero
+        const float CAVE_RADIUS = 0.07f;
+        const int CAVE_MIN_Y = 5;
+
+        const int DIRT_DEPTH = 3;
+
+        struct OreVein {
+            UVHelper::BlockType type;
+            int veinsPerChunk;
+            int size;
+            int minY;
+            int maxY;
+        };
+
+        const OreVein ORE_VEINS[] = {
+            { UVHelper::BlockType::COAL_ORE, 20, 12, 5, 128 },
+            { UVHelper::BlockType::IRON_ORE, 10, 8, 5, 64 },
+        };
+
+        // Tries per chunk, a try fails unless it lands on grass away from other trees and
+        // passes its biome's tree chance
+        const int TREE_ATTEMPTS = 12;
+        const int TREE_SPACING = 3;
+        const int TRUNK_MIN_HEIGHT = 4;
+        const int TRUNK_MAX_HEIGHT = 6;
+        const int LEAF_RADIUS = 2;
+
+        class StageTimer {
+        public:
+            explicit StageTimer(Stage timedStage) :
+                stage(timedStage),
+                zone(STAGE_NAMES[timedStage]),
+                start(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~StageTimer() {
+                stageNs[stage] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            }
+
+        private:
+            Stage stage;
+            Profiler::Zone zone;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        // Noise values on a grid over the chunk, every step blocks per axis, read back with
+        // trilinear interpolation. The grid covers one extra point so the far edge interpolates too
+        class Lattice {
+        public:
+            template <typename Noise>
+            Lattice(int originX, int originZ, int horizontalStep, int verticalStep, Noise noise) :
+                stepXZ(horizontalStep),
+                stepY(verticalStep),
+                sizeXZ(CHUNK_SIZE_X / horizontalStep + 1),
+                sizeY((CHUNK_SIZE_Y + verticalStep - 1) / verticalStep + 1),
+                values(sizeXZ * sizeY * sizeXZ)
+            {
+                for (int ix = 0; ix < sizeXZ; ++ix) {
+                    for (int iz = 0; iz < sizeXZ; ++iz) {
+                        for (int iy = 0; iy < sizeY; ++iy) {
+                            values[index(ix, iy, iz)] = noise(static_cast<float>(originX + ix * stepXZ),
+                                static_cast<float>(iy * stepY), static_cast<float>(originZ + iz * stepXZ));
+                        }
+                    }
+                }
+            }
+
+            float sample(int x, int y, int z) const {
+                int ix = x / stepXZ, iy = y / stepY, iz = z / stepXZ;
+                float fx = static_cast<float>(x - ix * stepXZ) / stepXZ;
+                float fy = static_cast<float>(y - iy * stepY) / stepY;
+                float fz = static_cast<float>(z - iz * stepXZ) / stepXZ;
+
+                float c00 = lerp(values[index(ix, iy, iz)], values[index(ix + 1, iy, iz)], fx);
+                float c10 = lerp(values[index(ix, iy + 1, iz)], values[index(ix + 1, iy + 1, iz)], fx);
+                float c01 = lerp(values[index(ix, iy, iz + 1)], values[index(ix + 1, iy, iz + 1)], fx);
+                float c11 = lerp(values[index(ix, iy + 1, iz + 1)], values[index(ix + 1, iy + 1, iz + 1)], fx);
+
+                return lerp(lerp(c00, c10, fy), lerp(c01, c11, fy), fz);
+            }
+
+        private:
+            int stepXZ, stepY;
+            int sizeXZ, sizeY;
+            std::vector<float> values;
+
+            int index(int ix, int iy, int iz) const {
+                return (ix * sizeXZ + iz) * sizeY + iy;
+            }
+
+            static float lerp(float a, float b, float t) {
+                return a + (b - a) * t;
+            }
+        };
+
+        struct ChunkContext {
+            int chunkX, chunkZ;
+            int originX, originZ;
+            int heights[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+            Biomes::BiomeType surfaceBiomes[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+            float treeChances[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+        };
+
+        // Higher wins. Terrain ranks above every structure block so trees never cut into it
+        int writePriority(UVHelper::BlockType type) {
+            switch (type) {
+            case UVHelper::BlockType::AIR: return 0;
+            case UVHelper::BlockType::OAKLEAVES: return 1;
+            case UVHelper::BlockType::OAKLOG: return 2;
+            default: return 3;
+            }
+        }
+
+        bool applyWrite(ChunkBlocks& blocks, int x, int y, int z, UVHelper::BlockType type) {
+            UVHelper::BlockType& block = blocks(x, y, z);
+            if (writePriority(type) <= writePriority(block)) return false;
+            block = type;
+            return true;
+        }
+
+        // x and z are relative to the chunk being generated and may reach into a neighbor
+        void placeStructureBlock(ChunkBlocks& blocks, PendingWrites& outgoing, int x, int y, int z, UVHelper::BlockType type) {
+            if (y < 0 || y >= CHUNK_SIZE_Y) return;
+
+            int offsetX = x < 0 ? -1 : (x >= CHUNK_SIZE_X ? 1 : 0);
+            int offsetZ = z < 0 ? -1 : (z >= CHUNK_SIZE_Z ? 1 : 0);
+            if (offsetX == 0 && offsetZ == 0) {
+                applyWrite(blocks, x, y, z, type);
+                return;
+            }
+
+            StructureWrite write = { x - offsetX * (int)CHUNK_SIZE_X, y, z - offsetZ * (int)CHUNK_SIZE_Z, type };
+            outgoing.neighbors[offsetX + 1][offsetZ + 1].push_back(write);
+        }
+
+        void placeTree(ChunkBlocks& blocks, PendingWrites& outgoing, int x, int groundY, int z, int trunkHeight) {
+            blocks(x, groundY, z) = UVHelper::BlockType::DIRT;
+
+            int top = groundY + trunkHeight;
+
+            // Two wide layers around the upper trunk, two narrow ones above it, corners left out
+            for (int y = top - 1; y <= top + 2; ++y) {
+                int radius = y < top + 1 ? LEAF_RADIUS : 1;
+                for (int dx = -radius; dx <= radius; ++dx) {
+                    for (int dz = -radius; dz <= radius; ++dz) {
+                        bool corner = std::abs(dx) == radius && std::abs(dz) == radius;
+                        if (corner && (radius == LEAF_RADIUS || y == top + 2)) continue;
+                        placeStructureBlock(blocks, outgoing, x + dx, y, z + dz, UVHelper::BlockType::OAKLEAVES);
+                    }
+                }
+            }
+
+            for (int y = groundY + 1; y <= top; ++y) {
+                placeStructureBlock(blocks, outgoing, x, y, z, UVHelper::BlockType::OAKLOG);
+            }
+        }
+
+        void climateStage(ChunkContext& context) {
+            StageTimer timer(CLIMATE);
+
+            Biomes::ClimateSampler climate;
+            for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    int worldX = context.originX + x;
+                    int worldZ = context.originZ + z;
+
+                    Biomes::ColumnClimate column = climate.sample(worldX, worldZ);
+                    context.heights[x][z] = terrainHeight(static_cast<float>(worldX), static_cast<float>(worldZ), column);
+                    context.surfaceBiomes[x][z] = Biomes::surfaceBiome(column, worldX, worldZ);
+                    context.treeChances[x][z] = column.treeChance;
+                }
+            }
+        }
+
+        void densityStage(ChunkContext& context, ChunkBlocks& blocks) {
+            StageTimer timer(DENSITY);
+
+            Lattice overhangs(context.originX, context.originZ, 4, 8, [](float x, float y, float z) {
+                return Noise::perlin(Noise::OVERHANGS, x * 0.04f, y * 0.04f, z * 0.04f) * OVERHANG_STRENGTH;
+            });
+
+            for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    int height = context.heights[x][z];
+
+                    // Without the noise this is solid exactly below height, like the plain height field.
+                    // The noise can only flip blocks within OVERHANG_STRENGTH of it
+                    int bandMin = std::max(0, height - static_cast<int>(OVERHANG_STRENGTH));
+                    int bandMax = std::min((int)CHUNK_SIZE_Y, height + static_cast<int>(OVERHANG_STRENGTH));
+
+                    for (int y = 0; y < bandMin; ++y) {
+                        blocks(x, y, z) = UVHelper::BlockType::STONE;
+                    }
+                    for (int y = bandMin; y < bandMax; ++y) {
+                        float density = height - y - 0.5f + overhangs.sample(x, y, z);
+                        blocks(x, y, z) = density > 0.0f ? UVHelper::BlockType::STONE : UVHelper::BlockType::AIR;
+                    }
+                    for (int y = bandMax; y < CHUNK_SIZE_Y; ++y) {
+                        blocks(x, y, z) = UVHelper::BlockType::AIR;
+                    }
+                }
+            }
+        }
+
+        void surfaceStage(ChunkContext& context, ChunkBlocks& blocks) {
+            StageTimer timer(SURFACE);
+
+            // Every stretch of stone that is open to the air above gets the biome's surface blocks,
+            // which covers overhangs as well as the ground below them
+            for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    const Biomes::Biome& biome = Biomes::getBiome(context.surfaceBiomes[x][z]);
+
+                    int depth = -1;
+                    for (int y = CHUNK_SIZE_Y - 1; y >= 0; --y) {
+                        UVHelper::BlockType& block = blocks(x, y, z);
+                        if (block == UVHelper::BlockType::AIR) {
+                            depth = -1;
+                            continue;
+                        }
+
+                        ++depth;
+                        if (depth == 0) {
+                            block = biome.surface;
+                        }
+                        else if (depth <= DIRT_DEPTH) {
+                            block = biome.subsurface;
+                        }
+                    }
+                }
+            }
+        }
+
+        void carverStage(ChunkContext& context, ChunkBlocks& blocks) {
+            StageTimer timer(CARVERS);
+
+            Lattice caveA(context.originX, context.originZ, 4, 4, [](float x, float y, float z) {
+                return Noise::perlin(Noise::CAVE_A, x * 0.025f, y * 0.05f, z * 0.025f);
+            });
+            Lattice caveB(context.originX, context.originZ, 4, 4, [](float x, float y, float z) {
+                return Noise::perlin(Noise::CAVE_B, x * 0.025f, y * 0.05f, z * 0.025f);
+            });
+
+            for (int x = 0; x < CHUNK_SIZE_X; ++x) {
+                for (int z = 0; z < CHUNK_SIZE_Z; ++z) {
+                    int top = std::min(context.heights[x][z] + static_cast<int>(OVERHANG_STRENGTH), (int)CHUNK_SIZE_Y);
+                    for (int y = CAVE_MIN_Y; y < top; ++y) {
+                        if (blocks(x, y, z) == UVHelper::BlockType::AIR) continue;
+
+                        float a = caveA.sample(x, y, z);
+                        float b = caveB.sample(x, y, z);
+                        if (a * a + b * b < CAVE_RADIUS * CAVE_RADIUS) {
+                            blocks(x, y, z) = UVHelper::BlockType::AIR;
+                        }
+                    }
+                }
+            }
+        }
+
+        void oreStage(ChunkContext& context, ChunkBlocks& blocks) {
+            StageTimer timer(ORES);
+
+            // Seeded per chunk so a chunk always gets the same veins
+            std::mt19937 random(Noise::chunkSeed(Noise::ORES, context.chunkX, context.chunkZ));
+
+            for (const OreVein& vein : ORE_VEINS) {
+                for (int i = 0; i < vein.veinsPerChunk; ++i) {
+                    int x = std::uniform_int_distribution<int>(0, CHUNK_SIZE_X - 1)(random);
+                    int y = std::uniform_int_distribution<int>(vein.minY, vein.maxY)(random);
+                    int z = std::uniform_int_distribution<int>(0, CHUNK_SIZE_Z - 1)(random);
+
+                    // A random walk, ore only replaces stone and stays inside the chunk
+                    for (int step = 0; step < vein.size; ++step) {
+                        if (x >= 0 && x < CHUNK_SIZE_X && y >= 0 && y < CHUNK_SIZE_Y && z >= 0 && z < CHUNK_SIZE_Z &&
+                            blocks(x, y, z) == UVHelper::BlockType::STONE) {
+                            blocks(x, y, z) = vein.type;
+                        }
+
+                        int direction = std::uniform_int_distribution<int>(0, 5)(random);
+                        int offset = direction % 2 == 0 ? 1 : -1;
+                        if (direction < 2) x += offset;
+                        else if (direction < 4) y += offset;
+                        else z += offset;
+                    }
+                }
+            }
+        }
+
+        void decorationStage(ChunkContext& context, ChunkBlocks& blocks, PendingWrites& outgoing) {
+            StageTimer timer(DECORATION);
+
+            std::mt19937 random(Noise::chunkSeed(Noise::TREES, context.chunkX, context.chunkZ));
+
+            // Sites are all picked before any tree is placed, so one tree's leaves can't hide
+            // the grass under the next
+            struct TreeSite {
+                int x, groundY, z, trunkHeight;
+            };
+            std::vector<TreeSite> sites;
+
+            for (int attempt = 0; attempt < TREE_ATTEMPTS; ++attempt) {
+                int x = std::uniform_int_distribution<int>(0, CHUNK_SIZE_X - 1)(random);
+                int z = std::uniform_int_distribution<int>(0, CHUNK_SIZE_Z - 1)(random);
+                int trunkHeight = std::uniform_int_distribution<int>(TRUNK_MIN_HEIGHT, TRUNK_MAX_HEIGHT)(random);
+                float chance = std::uniform_real_distribution<float>(0.0f, 1.0f)(random);
+                if (chance >= context.treeChances[x][z]) continue;
+
+                int groundY = std::min(context.heights[x][z] + static_cast<int>(OVERHANG_STRENGTH), (int)CHUNK_SIZE_Y - 1);
+                while (groundY > 0 && blocks(x, groundY, z) == UVHelper::BlockType::AIR) {
+                    --groundY;
+                }
+                if (blocks(x, groundY, z) != UVHelper::BlockType::GRASS) continue;
+                if (groundY + trunkHeight + 3 > CHUNK_SIZE_Y) continue;
+
+                bool crowded = false;
+                for (const TreeSite& site : sites) {
+                    if (std::abs(site.x - x) < TREE_SPACING && std::abs(site.z - z) < TREE_SPACING) crowded = true;
+                }
+                if (crowded) continue;
+
+                sites.push_back({ x, groundY, z, trunkHeight });
+            }
+
+            for (const TreeSite& site : sites) {
+                placeTree(blocks, outgoing, site.x, site.groundY, site.z, site.trunkHeight);
+            }
+        }
+    }
+
+    void generate(int chunkX, int chunkZ, ChunkBlocks& blocks, PendingWrites& outgoing) {
+        PROFILE_ZONE("TerrainGenerator::generate");
+
+        ChunkContext context;
+        context.chunkX = chunkX;
+        context.chunkZ = chunkZ;
+        context.originX = chunkX * CHUNK_SIZE_X;
+        context.originZ = chunkZ * CHUNK_SIZE_Z;
+
+        climateStage(context);
+        densityStage(context, blocks);
+        surfaceStage(context, blocks);
+        carverStage(context, blocks);
+        oreStage(context, blocks);
+        decorationStage(context, blocks, outgoing);
+
+        ++chunksGenerated;
+    }
+
+    int applyWrites(ChunkBlocks& blocks, const std::vector<StructureWrite>& writes) {
+        int changed = 0;
+        for (const StructureWrite& write : writes) {
+            if (applyWrite(blocks, write.x, write.y, write.z, write.type)) ++changed;
+        }
+        return changed;
+    }
+
+    float fbm(float x, float z) {
+        float total = 0.0f;
+        float frequency = 0.01f;
+        float amplitude = 1.0f;
+        float persistence = 0.5f;
+        float lacunarity = 2.0f;
+        int octaves = 6;
+        float maxAmplitude = 0.0f;
+
+        for (int i = 0; i < octaves; i++) {
+            total += Noise::perlin(Noise::HEIGHT, x * frequency, 0, z * frequency) * amplitude;
+            maxAmplitude += amplitude;
+            amplitude *= persistence;
+            frequency *= lacunarity;
+        }
+
+        total /= maxAmplitude;
+        return total;
+    }
+
+    int terrainHeight(float x, float z, const Biomes::ColumnClimate& column) {
+        float noiseValue = fbm(x, z);
+        noiseValue = (noiseValue + 1.0f) / 2.0f;
+
+        int height = static_cast<int>(column.baseHeight + (noiseValue - 0.5f) * column.heightRange);
+
+        // Room above for overhangs and the tallest tree
+        return std::max(1, std::min(height, (int)CHUNK_SIZE_Y - 16));
+    }
+
+    int terrainHeight(float x, float z) {
+        Biomes::ClimateSampler climate;
+        return terrainHeight(x, z, climate.sample(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(z))));
+    }
+
+    const char* getStageName(Stage stage) {
+        return STAGE_NAMES[stage];
+    }
+
+    double getStageTime(Stage stage) {
+        int chunks = chunksGenerated.load();
+        if (chunks == 0) return 0.0;
+        return stageNs[stage].load() / 1.0e6 / chunks;
+    }
+}
@@ -0,0 +1,214 @@
+#include "headerfiles/TextRenderer.hpp"
+#include "headerfiles/Stats.hpp"
+
+#include <cctype>
+#include <cstring>
+
+#include <glad/glad.h>
+
+namespace {
+    constexpr int GLYPH_WIDTH = 5;
+    constexpr int GLYPH_HEIGHT = 7;
+    // Every glyph gets an 8x8 cell in the font texture so neighbors never bleed in
+    constexpr int CELL_SIZE = 8;
+
+    const char GLYPH_CHARS[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.:/%-(),=+_";
+    constexpr int GLYPH_COUNT = sizeof(GLYPH_CHARS) - 1;
+    // One extra fully lit cell that rectangles sample from
+    constexpr int SOLID_CELL = GLYPH_COUNT;
+    constexpr int TEXTURE_WIDTH = (GLYPH_COUNT + 1) * CELL_SIZE;
+
+    // Rows from top to bottom, bit 4 is the leftmost pixel
+    const unsigned char GLYPH_ROWS[GLYPH_COUNT][GLYPH_HEIGHT] = {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+        { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // 0
+        { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 1
+        { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // 2
+        { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // 3
+        { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // 4
+        { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // 5
+        { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // 6
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // 7
+        { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // 8
+        { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // 9
+        { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // A
+        { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // B
+        { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // C
+        { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // D
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // E
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // F
+        { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // G
+        { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // H
+        { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // I
+        { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // J
+        { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // K
+        { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // L
+        { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+        { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // N
+        { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // O
+        { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // P
+        { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // Q
+        { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // R
+        { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // S
+        { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // U
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // V
+        { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // W
+        { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // X
+        { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // Y
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // Z
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // .
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // :
+        { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // /
+        { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // %
+        { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // -
+        { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // (
+        { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // )
+        { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ,
+        { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // =
+        { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // +
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F }, // _
+    };
+
+    int glyphIndex(char c) {
+        const char* found = std::strchr(GLYPH_CHARS, std::toupper(static_cast<unsigned char>(c)));
+        // Unknown characters, and the terminator strchr also matches, draw as a space
+        if (!found || *found == '\0') return 0;
+        return static_cast<int>(found - GLYPH_CHARS);
+    }
+}
+
+TextRenderer::TextRenderer(AssetManager& assets) :
+    shader(assets.loadShader("src/shaders/vs/text.vs", "src/shaders/fs/text.fs"))
+{
+    shader->onLoad = [](Shader& program) {
+        program.use();
+        program.setInt("fontTexture", 0);
+    };
+
+    unsigned char pixels[CELL_SIZE][TEXTURE_WIDTH] = {};
+    for (int glyph = 0; glyph < GLYPH_COUNT; ++glyph) {
+        for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+            for (int column = 0; column < GLYPH_WIDTH; ++column) {
+                if (GLYPH_ROWS[glyph][row] & (0x10 >> column)) {
+                    pixels[row][glyph * CELL_SIZE + column] = 255;
+                }
+            }
+        }
+    }
+    for (int row = 0; row < CELL_SIZE; ++row) {
+        std::memset(&pixels[row][SOLID_CELL * CELL_SIZE], 255, CELL_SIZE);
+    }
+
+    glGenTextures(1, &fontTexture);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, TEXTURE_WIDTH, CELL_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+}
+
+TextRenderer::~TextRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteTextures(1, &fontTexture);
+}
+
+void TextRenderer::begin(int screenWidth, int screenHeight) {
+    vertices.clear();
+    pixelToNdcX = 2.0f / static_cast<float>(screenWidth > 0 ? screenWidth : 1);
+    pixelToNdcY = 2.0f / static_cast<float>(screenHeight > 0 ? screenHeight : 1);
+}
+
+float TextRenderer::textWidth(const std::string& text, float scale) {
+    return static_cast<float>(text.size() * (GLYPH_WIDTH + 1)) * scale;
+}
+
+float TextRenderer::lineHeight(float scale) {
+    return static_cast<float>(GLYPH_HEIGHT + 3) * scale;
+}
+
+void TextRenderer::addQuad(float x, float y, float width, float height, float u0, float v0, float u1, float v1, const glm::vec4& color) {
+    float left = x * pixelToNdcX - 1.0f;
+    float right = (x + width) * pixelToNdcX - 1.0f;
+    float top = 1.0f - y * pixelToNdcY;
+    float bottom = 1.0f - (y + height) * pixelToNdcY;
+
+    const float corners[6][4] = {
+        { left,  top,    u0, v0 },
+        { left,  bottom, u0, v1 },
+        { right, bottom, u1, v1 },
+        { right, bottom, u1, v1 },
+        { right, top,    u1, v0 },
+        { left,  top,    u0, v0 },
+    };
+
+    for (const float* corner : corners) {
+        vertices.insert(vertices.end(), corner, corner + 4);
+        vertices.push_back(color.r);
+        vertices.push_back(color.g);
+        vertices.push_back(color.b);
+        vertices.push_back(color.a);
+    }
+}
+
+void TextRenderer::addRect(float x, float y, float width, float height, const glm::vec4& color) {
+    float u = (SOLID_CELL * CELL_SIZE + CELL_SIZE * 0.5f) / TEXTURE_WIDTH;
+    float v = 0.5f;
+    addQuad(x, y, width, height, u, v, u, v, color);
+}
+
+void TextRenderer::addText(float x, float y, const std::string& text, const glm::vec4& color, float scale) {
+    float penX = x;
+    for (char c : text) {
+        int glyph = glyphIndex(c);
+        if (glyph != 0) {
+            float u0 = static_cast<float>(glyph * CELL_SIZE) / TEXTURE_WIDTH;
+            float u1 = static_cast<float>(glyph * CELL_SIZE + GLYPH_WIDTH) / TEXTURE_WIDTH;
+            float v1 = static_cast<float>(GLYPH_HEIGHT) / CELL_SIZE;
+            addQuad(penX, y, GLYPH_WIDTH * scale, GLYPH_HEIGHT * scale, u0, 0.0f, u1, v1, color);
+        }
+        penX += (GLYPH_WIDTH + 1) * scale;
+    }
+}
+
+void TextRenderer::flush() {
+    if (vertices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    size_t bytes = vertices.size() * sizeof(float);
+    if (bytes > bufferCapacity) {
+        bufferCapacity = bytes * 2;
+    }
+    // Orphan the old storage so the driver doesn't wait on last frame's draw
+    glBufferData(GL_ARRAY_BUFFER, bufferCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+
+    shader->get().use();
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size() / 8));
+    ++Stats::drawCalls;
+    glBindVertexArray(0);
+}
@@ -1,17 +1,11 @@
 #include "headerfiles/UVHelper.hpp"
 
 namespace UVHelper {
-    UVCoords getUVCoords(int tileIndex, int tilesPerRow, int tileSize, int atlasSize) {
-        int x = tileIndex % tilesPerRow;
-        int y = tileIndex / tilesPerRow;
+    int getTileLayer(BlockType type, int face) {
+        const BlockUV& uvSet = blockTextures[type];
 
-        float uvTile = (float)tileSize / (float)atlasSize;
-
-        UVCoords uv {};
-        uv.uMin = x * uvTile;
-        uv.vMin = y * uvTile;
-        uv.uMax = (x + 1) * uvTile;
-        uv.vMax = (y + 1) * uvTile;
-        return uv;
+        if (face == 5) return uvSet.top;
+        if (face == 4) return uvSet.bottom;
+        return uvSet.side;
     }
 }
\ No newline at end of file
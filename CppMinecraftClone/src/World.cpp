@@ -1,30 +1,248 @@
 #include "headerfiles/World.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/GpuProfiler.hpp"
+#include "headerfiles/Stats.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 Chunk chunks[WORLD_SIZE_X][WORLD_SIZE_Z];
 
+static std::vector<Chunk*> dirtyChunks;
+
+// Runs job(chunkX, chunkZ) for every chunk on all hardware threads, each chunk on exactly one
+template <typename Job>
+static void forEachChunkParallel(Job job) {
+    std::atomic<int> nextChunk(0);
+    unsigned int workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::future<void>> workers;
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.push_back(std::async(std::launch::async, [&nextChunk, &job] {
+            for (int index = nextChunk++; index < WORLD_SIZE_X * WORLD_SIZE_Z; index = nextChunk++) {
+                job(index / WORLD_SIZE_Z, index % WORLD_SIZE_Z);
+            }
+        }));
+    }
+    for (std::future<void>& worker : workers) {
+        worker.get();
+    }
+}
+
 void generateWorld() {
+    PROFILE_ZONE("generateWorld");
+
+    // Chunks only write their own blocks. Trees reaching over the border leave those blocks
+    // in the chunk's pending writes
+    forEachChunkParallel([](int chunkRow, int chunkCell) {
+        Chunk& chunk = chunks[chunkRow][chunkCell];
+        chunk.chunkNumberX = chunkRow;
+        chunk.chunkNumberZ = chunkCell;
+        chunk.generateChunk();
+    });
+
+    // Every neighbor exists now, so each chunk pulls in what was left for it. Neighbors'
+    // buffers are only read here, and a chunk's blocks are only written by its own worker
+    forEachChunkParallel([](int chunkRow, int chunkCell) {
+        PROFILE_ZONE("generateWorld::applyStructureWrites");
+
+        for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+            for (int offsetZ = -1; offsetZ <= 1; ++offsetZ) {
+                int neighborX = chunkRow + offsetX;
+                int neighborZ = chunkCell + offsetZ;
+                if ((offsetX == 0 && offsetZ == 0) || neighborX < 0 || neighborX >= WORLD_SIZE_X || neighborZ < 0 || neighborZ >= WORLD_SIZE_Z)
+                    continue;
+
+                chunks[chunkRow][chunkCell].applyStructureWrites(chunks[neighborX][neighborZ].getPendingWrites(-offsetX, -offsetZ));
+            }
+        }
+    });
+
     for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
         for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
-            Chunk& chunk = chunks[chunkRow][chunkCell];
-            chunk.chunkNumberX = chunkRow;
-            chunk.chunkNumberZ = chunkCell;
-            chunk.generateChunk();
+            chunks[chunkRow][chunkCell].clearPendingWrites();
+        }
+    }
+}
+
+void benchmarkChunks(int rounds) {
+    typedef std::chrono::steady_clock Clock;
+
+    double generationMs = 0.0, meshingMs = 0.0;
+    for (int round = 0; round < rounds; ++round) {
+        Clock::time_point start = Clock::now();
+        for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
+            for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
+                Chunk& chunk = chunks[chunkRow][chunkCell];
+                chunk.chunkNumberX = chunkRow;
+                chunk.chunkNumberZ = chunkCell;
+                chunk.generateChunk();
+                chunk.clearPendingWrites();
+            }
+        }
+
+        // Meshing reads the neighbors' border blocks too, so it starts once every chunk exists
+        Clock::time_point generated = Clock::now();
+        for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
+            for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
+                chunks[chunkRow][chunkCell].generateMesh();
+            }
         }
+        Clock::time_point meshed = Clock::now();
+
+        generationMs += std::chrono::duration<double, std::milli>(generated - start).count();
+        meshingMs += std::chrono::duration<double, std::milli>(meshed - generated).count();
     }
+
+    int chunkCount = rounds * WORLD_SIZE_X * WORLD_SIZE_Z;
+    std::cout << "Block layout " << ChunkBlocks::LayoutType::getName() << ", " << chunkCount << " chunks: generation "
+        << generationMs / chunkCount << " ms per chunk, meshing " << meshingMs / chunkCount << " ms per chunk" << std::endl;
 }
 
-void renderWorld(Shader& ourShader) {
+void updateChunkStorage() {
+    PROFILE_ZONE("updateChunkStorage");
+
     for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
         for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, glm::vec3(chunkRow * CHUNK_SIZE_X, 0, chunkCell * CHUNK_SIZE_Z));
+            chunks[chunkRow][chunkCell].updateStorage();
+        }
+    }
+}
+
+void renderWorld(Shader& ourShader, const glm::vec3& cameraPos, int renderDistance) {
+    PROFILE_ZONE("renderWorld");
+
+    int playerChunkX = cameraPos.x / CHUNK_SIZE_X;
+    int playerChunkZ = cameraPos.z / CHUNK_SIZE_Z;
+
+    int renderBoundXLeft = std::max(0, playerChunkX - renderDistance);
+    int renderBoundXRight = std::min((int)WORLD_SIZE_X, playerChunkX + renderDistance + 1);
+    int renderBoundZLeft = std::max(0, playerChunkZ - renderDistance);
+    int renderBoundZRight = std::min((int)WORLD_SIZE_Z, playerChunkZ + renderDistance + 1);
+
+    int chunksInRange = (renderBoundXRight - renderBoundXLeft) * (renderBoundZRight - renderBoundZLeft);
+    Stats::chunksCulled += WORLD_SIZE_X * WORLD_SIZE_Z - std::max(0, chunksInRange);
+
+    std::vector<std::pair<float, Chunk*>> transparentChunks;
+
+    // Solid pass
+    {
+        GpuProfiler::Scope timer(GpuProfiler::SOLID_CHUNKS);
+
+        for (int chunkRow = renderBoundXLeft; chunkRow < renderBoundXRight; chunkRow++) {
+            for (int chunkCell = renderBoundZLeft; chunkCell < renderBoundZRight; chunkCell++) {
+                glm::mat4 model = glm::mat4(1.0f);
+                model = glm::translate(model, glm::vec3(chunkRow * CHUNK_SIZE_X, 0, chunkCell * CHUNK_SIZE_Z));
+                ourShader.setMatrix("model", model);
+
+                glm::vec2 chunkCenter((chunkRow + 0.5f) * CHUNK_SIZE_X, (chunkCell + 0.5f) * CHUNK_SIZE_Z);
+                glm::vec2 toCamera = glm::vec2(cameraPos.x, cameraPos.z) - chunkCenter;
+                float chunkDistance = glm::length(toCamera / glm::vec2(CHUNK_SIZE_X, CHUNK_SIZE_Z));
+
+                Chunk& chunk = chunks[chunkRow][chunkCell];
+                chunk.updateLod(chunkDistance);
+                chunk.renderSolid(ourShader);
+
+                if (chunk.hasTransparentFaces()) {
+                    transparentChunks.push_back({ glm::dot(toCamera, toCamera), &chunk });
+                }
+            }
+        }
+    }
+
+    // Transparent pass, back to front
+    {
+        GpuProfiler::Scope timer(GpuProfiler::TRANSPARENT_CHUNKS);
+
+        std::sort(transparentChunks.begin(), transparentChunks.end(), [](const std::pair<float, Chunk*>& a, const std::pair<float, Chunk*>& b) {
+            return a.first > b.first;
+        });
+
+        for (const std::pair<float, Chunk*>& entry : transparentChunks) {
+            Chunk& chunk = *entry.second;
+            glm::vec3 chunkOrigin(chunk.chunkNumberX * CHUNK_SIZE_X, 0, chunk.chunkNumberZ * CHUNK_SIZE_Z);
+
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkOrigin);
             ourShader.setMatrix("model", model);
 
-            Chunk& chunk = chunks[chunkRow][chunkCell];
-            chunk.render(ourShader);
+            chunk.renderTransparent(ourShader, cameraPos - chunkOrigin);
         }
     }
+}
+
+UVHelper::BlockType getWorldBlock(int x, int y, int z) {
+    if (x < 0 || z < 0) return UVHelper::BlockType::AIR;
+
+    int chunkX = x / static_cast<int>(CHUNK_SIZE_X);
+    int chunkZ = z / static_cast<int>(CHUNK_SIZE_Z);
+    if (chunkX >= WORLD_SIZE_X || chunkZ >= WORLD_SIZE_Z) return UVHelper::BlockType::AIR;
+
+    return chunks[chunkX][chunkZ].getBlock(x - chunkX * CHUNK_SIZE_X, y, z - chunkZ * CHUNK_SIZE_Z);
+}
+
+int getWorldHeight(int x, int z, Heightmap::Type type) {
+    if (x < 0 || z < 0) return 0;
+
+    int chunkX = x / static_cast<int>(CHUNK_SIZE_X);
+    int chunkZ = z / static_cast<int>(CHUNK_SIZE_Z);
+    if (chunkX >= WORLD_SIZE_X || chunkZ >= WORLD_SIZE_Z) return 0;
+
+    return chunks[chunkX][chunkZ].getHeight(x - chunkX * CHUNK_SIZE_X, z - chunkZ * CHUNK_SIZE_Z, type);
+}
+
+int getWorldHeightAt(float x, float z, Heightmap::Type type) {
+    return getWorldHeight(static_cast<int>(std::floor(x + 0.5f)), static_cast<int>(std::floor(z + 0.5f)), type);
+}
+
+void setBlock(int x, int y, int z, UVHelper::BlockType blockType) {
+    if (x < 0 || y < 0 || z < 0 || y >= CHUNK_SIZE_Y) return;
+
+    int chunkX = x / static_cast<int>(CHUNK_SIZE_X);
+    int chunkZ = z / static_cast<int>(CHUNK_SIZE_Z);
+    if (chunkX >= WORLD_SIZE_X || chunkZ >= WORLD_SIZE_Z) return;
+
+    int localX = x - chunkX * CHUNK_SIZE_X;
+    int localZ = z - chunkZ * CHUNK_SIZE_Z;
+
+    chunks[chunkX][chunkZ].Add(localX, y, localZ, blockType);
+    markChunkDirty(chunkX, chunkZ);
+
+    // Border blocks change which faces the neighbor has to draw
+    if (localX == 0) markChunkDirty(chunkX - 1, chunkZ);
+    else if (localX == CHUNK_SIZE_X - 1) markChunkDirty(chunkX + 1, chunkZ);
+
+    if (localZ == 0) markChunkDirty(chunkX, chunkZ - 1);
+    else if (localZ == CHUNK_SIZE_Z - 1) markChunkDirty(chunkX, chunkZ + 1);
+}
+
+void markChunkDirty(int chunkX, int chunkZ) {
+    if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) return;
+
+    Chunk& chunk = chunks[chunkX][chunkZ];
+    chunk.markDirty();
+
+    if (!chunk.queuedForRemesh) {
+        chunk.queuedForRemesh = true;
+        dirtyChunks.push_back(&chunk);
+    }
+}
+
+void flushEdits() {
+    PROFILE_ZONE("flushEdits");
+
+    // A chunk that is still meshing picks its pending edits up once that job finishes
+    for (Chunk* chunk : dirtyChunks) {
+        chunk->queuedForRemesh = false;
+        chunk->regenMesh();
+    }
+    dirtyChunks.clear();
 }
\ No newline at end of file
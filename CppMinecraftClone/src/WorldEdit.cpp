@@ -0,0 +1,113 @@
+#include "headerfiles/WorldEdit.hpp"
+#include "headerfiles/World.hpp"
+
+#include <algorithm>
+
+namespace {
+    // Calls fn(chunk, localMin, localMax) for every chunk the box overlaps, local bounds
+    // are inclusive. Queues each chunk, and any neighbor sharing an edited border, afterwards
+    template <typename Fn>
+    void forEachChunkInBox(glm::ivec3 boxMin, glm::ivec3 boxMax, Fn fn) {
+        boxMin = glm::max(boxMin, glm::ivec3(0));
+        boxMax = glm::min(boxMax, glm::ivec3(WORLD_SIZE_X * CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, WORLD_SIZE_Z * CHUNK_SIZE_Z - 1));
+        if (boxMin.x > boxMax.x || boxMin.y > boxMax.y || boxMin.z > boxMax.z) return;
+
+        for (int chunkX = boxMin.x / CHUNK_SIZE_X; chunkX <= boxMax.x / static_cast<int>(CHUNK_SIZE_X); ++chunkX) {
+            for (int chunkZ = boxMin.z / CHUNK_SIZE_Z; chunkZ <= boxMax.z / static_cast<int>(CHUNK_SIZE_Z); ++chunkZ) {
+                glm::ivec3 chunkOrigin(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
+                glm::ivec3 localMin = glm::max(boxMin - chunkOrigin, glm::ivec3(0));
+                glm::ivec3 localMax = glm::min(boxMax - chunkOrigin, glm::ivec3(CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, CHUNK_SIZE_Z - 1));
+
+                fn(chunks[chunkX][chunkZ], localMin, localMax);
+
+                markChunkDirty(chunkX, chunkZ);
+                if (localMin.x == 0) markChunkDirty(chunkX - 1, chunkZ);
+                if (localMax.x == CHUNK_SIZE_X - 1) markChunkDirty(chunkX + 1, chunkZ);
+                if (localMin.z == 0) markChunkDirty(chunkX, chunkZ - 1);
+                if (localMax.z == CHUNK_SIZE_Z - 1) markChunkDirty(chunkX, chunkZ + 1);
+            }
+        }
+    }
+}
+
+namespace WorldEdit {
+    void fill(glm::ivec3 cornerA, glm::ivec3 cornerB, UVHelper::BlockType blockType) {
+        forEachChunkInBox(glm::min(cornerA, cornerB), glm::max(cornerA, cornerB),
+            [blockType](Chunk& chunk, glm::ivec3 localMin, glm::ivec3 localMax) {
+                int rowLength = localMax.z - localMin.z + 1;
+                for (int x = localMin.x; x <= localMax.x; ++x) {
+                    for (int y = localMin.y; y <= localMax.y; ++y) {
+                        chunk.fillRow(x, y, localMin.z, rowLength, blockType);
+                    }
+                }
+            });
+    }
+
+    int replace(glm::ivec3 cornerA, glm::ivec3 cornerB, UVHelper::BlockType from, UVHelper::BlockType to) {
+        int replaced = 0;
+
+        forEachChunkInBox(glm::min(cornerA, cornerB), glm::max(cornerA, cornerB),
+            [from, to, &replaced](Chunk& chunk, glm::ivec3 localMin, glm::ivec3 localMax) {
+                int rowLength = localMax.z - localMin.z + 1;
+                for (int x = localMin.x; x <= localMax.x; ++x) {
+                    for (int y = localMin.y; y <= localMax.y; ++y) {
+                        replaced += chunk.replaceRow(x, y, localMin.z, rowLength, from, to);
+                    }
+                }
+            });
+
+        return replaced;
+    }
+
+    Clipboard copy(glm::ivec3 cornerA, glm::ivec3 cornerB) {
+        glm::ivec3 boxMin = glm::min(cornerA, cornerB);
+        glm::ivec3 boxMax = glm::max(cornerA, cornerB);
+
+        Clipboard clipboard;
+        clipboard.size = boxMax - boxMin + 1;
+        clipboard.blocks.assign(static_cast<size_t>(clipboard.size.x) * clipboard.size.y * clipboard.size.z, UVHelper::BlockType::AIR);
+
+        glm::ivec3 worldMin = glm::max(boxMin, glm::ivec3(0));
+        glm::ivec3 worldMax = glm::min(boxMax, glm::ivec3(WORLD_SIZE_X * CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, WORLD_SIZE_Z * CHUNK_SIZE_Z - 1));
+        if (worldMin.x > worldMax.x || worldMin.y > worldMax.y || worldMin.z > worldMax.z) return clipboard;
+
+        // Reading doesn't dirty anything, so walk the chunks here instead of forEachChunkInBox
+        for (int chunkX = worldMin.x / CHUNK_SIZE_X; chunkX <= worldMax.x / static_cast<int>(CHUNK_SIZE_X); ++chunkX) {
+            for (int chunkZ = worldMin.z / CHUNK_SIZE_Z; chunkZ <= worldMax.z / static_cast<int>(CHUNK_SIZE_Z); ++chunkZ) {
+                glm::ivec3 chunkOrigin(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
+                glm::ivec3 localMin = glm::max(worldMin - chunkOrigin, glm::ivec3(0));
+                glm::ivec3 localMax = glm::min(worldMax - chunkOrigin, glm::ivec3(CHUNK_SIZE_X - 1, CHUNK_SIZE_Y - 1, CHUNK_SIZE_Z - 1));
+                int rowLength = localMax.z - localMin.z + 1;
+
+                const Chunk& chunk = chunks[chunkX][chunkZ];
+                for (int x = localMin.x; x <= localMax.x; ++x) {
+                    for (int y = localMin.y; y <= localMax.y; ++y) {
+                        glm::ivec3 offset = chunkOrigin + glm::ivec3(x, y, localMin.z) - boxMin;
+                        size_t index = (static_cast<size_t>(offset.x) * clipboard.size.y + offset.y) * clipboard.size.z + offset.z;
+                        chunk.readRow(x, y, localMin.z, rowLength, &clipboard.blocks[index]);
+                    }
+                }
+            }
+        }
+
+        return clipboard;
+    }
+
+    void paste(const Clipboard& clipboard, glm::ivec3 origin, bool skipAir) {
+        if (clipboard.blocks.empty()) return;
+
+        forEachChunkInBox(origin, origin + clipboard.size - 1,
+            [&clipboard, origin, skipAir](Chunk& chunk, glm::ivec3 localMin, glm::ivec3 localMax) {
+                glm::ivec3 chunkOrigin(chunk.chunkNumberX * CHUNK_SIZE_X, 0, chunk.chunkNumberZ * CHUNK_SIZE_Z);
+                int rowLength = localMax.z - localMin.z + 1;
+
+                for (int x = localMin.x; x <= localMax.x; ++x) {
+                    for (int y = localMin.y; y <= localMax.y; ++y) {
+                        glm::ivec3 offset = chunkOrigin + glm::ivec3(x, y, localMin.z) - origin;
+                        size_t index = (static_cast<size_t>(offset.x) * clipboard.size.y + offset.y) * clipboard.size.z + offset.z;
+                        chunk.writeRow(x, y, localMin.z, rowLength, &clipboard.blocks[index], skipAir);
+                    }
+                }
+            });
+    }
+}
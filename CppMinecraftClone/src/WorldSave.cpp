@@ -0,0 +1,137 @@
+#include "headerfiles/WorldSave.hpp"
+#include "headerfiles/Noise.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/TerrainGenerator.hpp"
+#include "headerfiles/World.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const char SAVE_MAGIC[4] = { 'M', 'C', 'W', 'S' };
+    // 2 stores chunks as column runs
+    constexpr uint32_t SAVE_VERSION = 2;
+
+    template <typename T>
+    void writeValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    bool openSave(std::ifstream& file, const std::string& path, WorldSave::Header& header) {
+        file.open(path, std::ios::binary);
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        if (!file || !file.read(magic, sizeof(magic)) || !readValue(file, version) ||
+            std::string(magic, 4) != std::string(SAVE_MAGIC, 4) || version != SAVE_VERSION ||
+            !readValue(file, header.generationVersion) || !readValue(file, header.seed) || !readValue(file, header.chunkCount)) {
+            std::cout << "ERROR::SAVE::INVALID_WORLD: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+}
+
+namespace WorldSave {
+    bool readHeader(const std::string& path, Header& header) {
+        std::ifstream file;
+        return openSave(file, path, header);
+    }
+
+    bool loadChunks(const std::string& path) {
+        PROFILE_ZONE("WorldSave::loadChunks");
+
+        std::ifstream file;
+        Header header;
+        if (!openSave(file, path, header)) return false;
+
+        // Only edited chunks are stored, the rest come from a generator that may differ now
+        if (header.generationVersion != TerrainGenerator::GENERATION_VERSION) {
+            std::cout << "WARNING::SAVE::GENERATION_VERSION: saved with " << header.generationVersion << ", generating with "
+                << TerrainGenerator::GENERATION_VERSION << ", unedited chunks will differ" << std::endl;
+        }
+
+        std::vector<ColumnRuns::Run> runs;
+        ColumnRuns columns;
+        for (uint32_t i = 0; i < header.chunkCount; ++i) {
+            int32_t chunkX = 0, chunkZ = 0;
+            uint32_t runCount = 0;
+            if (!readValue(file, chunkX) || !readValue(file, chunkZ) || !readValue(file, runCount)) {
+                std::cout << "ERROR::SAVE::TRUNCATED_WORLD: " << path << std::endl;
+                return false;
+            }
+
+            runs.resize(runCount);
+            for (ColumnRuns::Run& run : runs) {
+                if (!readValue(file, run.type) || !readValue(file, run.end)) {
+                    std::cout << "ERROR::SAVE::TRUNCATED_WORLD: " << path << std::endl;
+                    return false;
+                }
+            }
+
+            if (chunkX < 0 || chunkX >= (int)WORLD_SIZE_X || chunkZ < 0 || chunkZ >= (int)WORLD_SIZE_Z) continue;
+
+            if (!columns.assign(runs)) {
+                std::cout << "ERROR::SAVE::BAD_CHUNK: " << chunkX << ", " << chunkZ << std::endl;
+                continue;
+            }
+            chunks[chunkX][chunkZ].writeColumns(columns);
+            markChunkDirty(chunkX, chunkZ);
+        }
+
+        std::cout << "Loaded " << header.chunkCount << " edited chunks from " << path << std::endl;
+        return true;
+    }
+
+    bool save(const std::string& path) {
+        PROFILE_ZONE("WorldSave::save");
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cout << "ERROR::SAVE::COULD_NOT_OPEN_WORLD: " << path << std::endl;
+            return false;
+        }
+
+        uint32_t chunkCount = 0;
+        for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
+            for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
+                if (chunks[chunkRow][chunkCell].modified) ++chunkCount;
+            }
+        }
+
+        file.write(SAVE_MAGIC, sizeof(SAVE_MAGIC));
+        writeValue(file, SAVE_VERSION);
+        writeValue(file, TerrainGenerator::GENERATION_VERSION);
+        writeValue(file, Noise::getSeed());
+        writeValue(file, chunkCount);
+
+        ColumnRuns columns;
+        for (int chunkRow = 0; chunkRow < WORLD_SIZE_X; chunkRow++) {
+            for (int chunkCell = 0; chunkCell < WORLD_SIZE_Z; chunkCell++) {
+                const Chunk& chunk = chunks[chunkRow][chunkCell];
+                if (!chunk.modified) continue;
+
+                chunk.readColumns(columns);
+                const std::vector<ColumnRuns::Run>& runs = columns.getRuns();
+
+                writeValue(file, static_cast<int32_t>(chunkRow));
+                writeValue(file, static_cast<int32_t>(chunkCell));
+                writeValue(file, static_cast<uint32_t>(runs.size()));
+                for (const ColumnRuns::Run& run : runs) {
+                    writeValue(file, run.type);
+                    writeValue(file, run.end);
+                }
+            }
+        }
+
+        std::cout << "Saved " << chunkCount << " of " << WORLD_SIZE_X * WORLD_SIZE_Z << " chunks to " << path << std::endl;
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.hpp"
+
+// A tile atlas split into the layers of a GL_TEXTURE_2D_ARRAY. The texture name stays the
+// same across hot reloads, only its contents are replaced
+class TextureArrayAsset {
+public:
+    ~TextureArrayAsset();
+
+    unsigned int getId() const { return id; }
+    bool isReady() const { return ready; }
+
+private:
+    friend class AssetManager;
+
+    unsigned int id = 0;
+    bool ready = false;
+};
+
+class ShaderAsset {
+public:
+    // Only valid once ready, startup fails if a program never loads. A hot reload swaps the
+    // program, so don't keep the reference across frames
+    Shader& get() { return *shader; }
+    bool isReady() const { return shader != nullptr && shader->isLinked(); }
+
+    // Runs on the main thread after every (re)load, for uniforms that are only set once
+    std::function<void(Shader&)> onLoad;
+
+private:
+    friend class AssetManager;
+
+    std::unique_ptr<Shader> shader;
+};
+
+// Reads and decodes assets on worker threads and finishes them on the main thread in update().
+// Assets are shared by path and freed once the last handle is released. Files are watched
+// and changed assets are reloaded in place
+class AssetManager {
+public:
+    ~AssetManager();
+
+    std::shared_ptr<TextureArrayAsset> loadTextureArray(const std::string& path, int tileSize, int tilesPerRow);
+    std::shared_ptr<ShaderAsset> loadShader(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Main thread, once per frame. Uploads finished jobs and checks watched files
+    void update();
+    // Runs update until every requested asset has loaded
+    void finishLoading();
+    bool isLoading() const;
+
+private:
+    struct DecodedTiles {
+        bool valid = false;
+        int tileSize = 0;
+        int layers = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    struct TextureEntry {
+        std::string path;
+        int tileSize = 0;
+        int tilesPerRow = 0;
+        std::weak_ptr<TextureArrayAsset> asset;
+        std::future<DecodedTiles> job;
+        int64_t modified = 0;
+    };
+
+    struct ShaderEntry {
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::weak_ptr<ShaderAsset> asset;
+        std::future<std::pair<bool, ShaderSource>> job;
+        int64_t vertexModified = 0;
+        int64_t fragmentModified = 0;
+    };
+
+    std::unordered_map<std::string, TextureEntry> textures;
+    std::unordered_map<std::string, ShaderEntry> shaders;
+
+    // Staging buffer for texture uploads, reused by every texture
+    unsigned int uploadPBO = 0;
+
+    std::chrono::steady_clock::time_point lastWatchCheck = std::chrono::steady_clock::now();
+
+    static DecodedTiles decodeTiles(const std::string& path, int tileSize, int tilesPerRow);
+    void uploadTiles(TextureArrayAsset& asset, const DecodedTiles& tiles);
+    void startTextureJob(TextureEntry& entry);
+    void startShaderJob(ShaderEntry& entry);
+    void checkForChanges();
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "UVHelper.hpp"
+
+// Temperature and humidity vary slowly across the world and decide which biomes a column
+// belongs to. Both are sampled every few blocks into square regions that sit in a bounded
+// LRU cache, so chunks generated next to each other share samples instead of evaluating
+// climate noise per column
+namespace Biomes {
+    enum BiomeType {
+        PLAINS,
+        FOREST,
+        DESERT,
+        MOUNTAINS,
+        BIOME_COUNT
+    };
+
+    struct Biome {
+        const char* name;
+        // Where the biome sits in climate space
+        float temperature;
+        float humidity;
+        // Column height is baseHeight + (noise - 0.5) * heightRange, noise being the 0..1 fBm
+        float baseHeight;
+        float heightRange;
+        UVHelper::BlockType surface;
+        UVHelper::BlockType subsurface;
+        // Chance that a tree attempt on this biome grows a tree
+        float treeChance;
+    };
+
+    const Biome& getBiome(BiomeType type);
+
+    // Every biome's weight at one column, and their parameters blended by those weights
+    struct ColumnClimate {
+        float weights[BIOME_COUNT];
+        float baseHeight;
+        float heightRange;
+        float treeChance;
+    };
+
+    // Biome whose blocks cover a column. Blocks can't be averaged, so the pick is dithered
+    // per column by the weights and borders fray instead of running in a straight line
+    BiomeType surfaceBiome(const ColumnClimate& climate, int x, int z);
+
+    struct ClimateRegion;
+
+    // Holds on to the region it read last, so neighboring columns skip the cache lookup.
+    // Not thread safe, use one per thread
+    class ClimateSampler {
+    public:
+        ColumnClimate sample(int x, int z);
+
+    private:
+        std::shared_ptr<const ClimateRegion> region;
+        int regionX = 0, regionZ = 0;
+    };
+
+    // Climate read straight from the noise. For lookups spread too far apart to reuse regions,
+    // like the far terrain, which would otherwise evict the regions chunk generation is using.
+    // Matches the cached climate on the sample grid and stays within its interpolation elsewhere
+    ColumnClimate sampleUncached(int x, int z);
+
+    // Cache counters for the stats overlay
+    int getCachedRegions();
+    int64_t getCacheHits();
+    int64_t getCacheMisses();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Constants.hpp"
+#include "UVHelper.hpp"
+
+// Orders a chunk's blocks can be stored in. Each maps local (x, y, z) to an index into one flat
+// array, ChunkBlocks takes the layout as a template parameter so the mapping inlines
+namespace BlockLayout {
+    // x, then y, then z. Rows along z are contiguous, the order chunks have always used
+    struct XYZ {
+        static const char* getName() { return "XYZ"; }
+        static constexpr int SIZE = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+        static constexpr bool CONTIGUOUS_ROWS = true;
+
+        static int index(int x, int y, int z) { return (x * CHUNK_SIZE_Y + y) * CHUNK_SIZE_Z + z; }
+    };
+
+    // y, then x, then z. A horizontal slice is one stretch of memory, so neighbors along x are a
+    // row apart instead of a whole x plane
+    struct YXZ {
+        static const char* getName() { return "YXZ"; }
+        static constexpr int SIZE = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+        static constexpr bool CONTIGUOUS_ROWS = true;
+
+        static int index(int x, int y, int z) { return (y * CHUNK_SIZE_X + x) * CHUNK_SIZE_Z + z; }
+    };
+
+    // Sections 16 blocks high, each in Morton (Z) order so blocks near each other along any
+    // axis are near each other in memory. Rows along z are not contiguous
+    struct Morton {
+        static constexpr int SECTION_HEIGHT = 16;
+        static constexpr int SECTION_VOLUME = CHUNK_SIZE_X * SECTION_HEIGHT * CHUNK_SIZE_Z;
+        static constexpr int SECTIONS = (CHUNK_SIZE_Y + SECTION_HEIGHT - 1) / SECTION_HEIGHT;
+        static_assert(CHUNK_SIZE_X == 32 && CHUNK_SIZE_Z == 32, "Morton interleaves 5 bits of x and z");
+
+        static const char* getName() { return "Morton"; }
+        static constexpr int SIZE = SECTIONS * SECTION_VOLUME;
+        static constexpr bool CONTIGUOUS_ROWS = false;
+
+        static int index(int x, int y, int z) {
+            // Three low nibbles interleaved, the fifth bit of x and z sits above them
+            int inSection = spreadNibble(x) | spreadNibble(y) << 1 | spreadNibble(z) << 2 |
+                (x & 16) << 8 | (z & 16) << 9;
+            return (y / SECTION_HEIGHT) * SECTION_VOLUME + inSection;
+        }
+
+    private:
+        // Moves bits 0-3 to bits 0, 3, 6 and 9
+        static int spreadNibble(int value) {
+            value &= 15;
+            value = (value | value << 4) & 0x0C3;
+            return (value | value << 2) & 0x249;
+        }
+    };
+
+    // A chunk's blocks in the given layout
+    template <typename Layout>
+    class Blocks {
+    public:
+        typedef Layout LayoutType;
+
+        UVHelper::BlockType& operator()(int x, int y, int z) { return data[Layout::index(x, y, z)]; }
+        UVHelper::BlockType operator()(int x, int y, int z) const { return data[Layout::index(x, y, z)]; }
+
+    private:
+        UVHelper::BlockType data[Layout::SIZE];
+    };
+}
+
+// Layout every chunk is built with. Define CHUNK_BLOCK_LAYOUT as XYZ, YXZ or Morton to compare
+// them with --chunk-benchmark
+#ifndef CHUNK_BLOCK_LAYOUT
+#define CHUNK_BLOCK_LAYOUT XYZ
+#endif
+
+typedef BlockLayout::Blocks<BlockLayout::CHUNK_BLOCK_LAYOUT> ChunkBlocks;
@@ -2,6 +2,8 @@
 
 #include "Shader.hpp"
 #include "Player.hpp"
+#include "Input.hpp"
+#include "Collision.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -16,9 +18,13 @@ public:
 
     Player& curPlayer;
 
-    void processCameraInput(GLFWwindow* window, float& deltaTime, bool sprinting);
+    // Advances movement and gravity by one simulation tick
+    void processCameraInput(const InputFrame& input, float deltaTime, bool sprinting);
+    // Blends the drawn position between the previous and the latest tick, alpha in [0, 1]
+    void interpolate(float alpha);
     void setCamera(Shader& ourShader);
-    void setProjection(Shader& ourShader);
+    void setProjection(Shader& ourShader, double nearPlane = 0.1, double farPlane = 1000.0);
+    // Interpolated position the current frame is drawn from
     glm::vec3 getCamPos();
     glm::vec3 getCamTarget();
     glm::vec3 getCamUp();
@@ -28,18 +34,27 @@ public:
     
     void updateFOV(bool isSprinting, float deltaTime);
 
-    bool horizontalCollision(glm::vec3 pos);
-    float groundedCheck(float currentVelocity);
-    void headerCheck(float& currentVelocity);
+    // False when a block placed there would overlap the player
     bool blockPlaceCheck(glm::ivec3 blockPlacePos);
 
+    void processMouse(double xpos, double ypos);
+    void processScroll(double yoffset);
+
+    // Moves the camera straight to a pose, used by scripted camera paths
+    void setPose(const glm::vec3& position, double newYaw, double newPitch);
+    // Stands the player on the highest block below the camera, the world has to be generated
+    void placeOnGround();
+
 private:
     // Gravity stuff
     bool isGrounded;
     float velocity;
     // ----
 
+    // Simulation state, updated once per tick
     glm::vec3 cameraPos;
+    glm::vec3 previousPos;
+    glm::vec3 renderPos;
     glm::vec3 cameraTarget;
     glm::vec3 cameraUp;
 
@@ -53,9 +68,6 @@ private:
     double lastY;
     bool firstMouse;
 
-    static void mouse_callback(GLFWwindow* window, double xpos, double ypos);
-    static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
-
-    void processMouse(double xpos, double ypos);
-    void processScroll(double yoffset);
+    void updateTarget();
+    Collision::AABB getPlayerBox() const;
 };
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Scripted camera motion for benchmark runs. Keyframes are linearly interpolated by time
+class CameraPath {
+public:
+    struct Keyframe {
+        float time;
+        glm::vec3 position;
+        double yaw;
+        double pitch;
+    };
+
+    // One keyframe per line: time x y z yaw pitch, lines starting with # are skipped
+    bool load(const std::string& path);
+    // Straight flight across the middle of the world
+    static CameraPath flyover();
+
+    float duration() const;
+    Keyframe sample(float time) const;
+
+private:
+    std::vector<Keyframe> keyframes;
+};
@@ -1,40 +1,121 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <future>
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
 
 #include "Constants.hpp"
+#include "headerfiles/ColumnRuns.hpp"
+#include "headerfiles/Heightmap.hpp"
+#include "headerfiles/MeshArena.hpp"
 #include "headerfiles/Shader.hpp"
+#include "headerfiles/TerrainGenerator.hpp"
 #include "headerfiles/UVHelper.hpp"
 
+// Creates a VAO and its buffers, leaves them bound and sets up the TERRAIN_VERTEX_FLOATS vertex
+// layout. Chunk and far terrain meshes share it so their formats can't drift apart
+void setupMeshBuffers(unsigned int& VAO, unsigned int& VBO, unsigned int& EBO);
 
 class Chunk {
 public:
+    Chunk();
     ~Chunk();
 
     void regenMesh();
+    void markDirty();
+    bool isMeshing() const;
     void Add(int x, int y, int z, UVHelper::BlockType blockType, bool regenerateMesh = false);
     void removeBlock(int x, int y, int z);
 
     UVHelper::BlockType getBlock(int x, int y, int z);
+    // One above the highest block of the column that counts for the heightmap, 0 when none does
+    int getHeight(int x, int z, Heightmap::Type type) const;
 
-    float fbm(float x, float z);
+    // Row primitives for bulk edits, a row runs along z at a fixed (x, y). They skip
+    // markDirty so callers can flag the chunk once after touching many rows
+    void fillRow(int x, int y, int zStart, int count, UVHelper::BlockType blockType);
+    int replaceRow(int x, int y, int zStart, int count, UVHelper::BlockType from, UVHelper::BlockType to);
+    void readRow(int x, int y, int zStart, int count, UVHelper::BlockType* out) const;
+    void writeRow(int x, int y, int zStart, int count, const UVHelper::BlockType* in, bool skipAir);
 
     void generateChunk();
 
+    // Blocks as column runs, for saving. writeColumns replaces every block of the chunk
+    void readColumns(ColumnRuns& out) const;
+    void writeColumns(const ColumnRuns& in);
+
+    // Main thread, once per frame. Compresses the chunk into column runs once it has gone a
+    // while without edits or meshing, and decodes it again when run lookups get frequent
+    void updateStorage();
+    bool isCompressed() const;
+
+    // Structure blocks this chunk's generation left for the neighbor at the given chunk offset
+    const std::vector<TerrainGenerator::StructureWrite>& getPendingWrites(int offsetX, int offsetZ) const;
+    void clearPendingWrites();
+    // Takes in structure blocks from a neighbor, only call once this chunk is generated
+    void applyStructureWrites(const std::vector<TerrainGenerator::StructureWrite>& writes);
+
     bool isNeighborClear(UVHelper::BlockType neighborBlock, UVHelper::BlockType currentBlock) const;
     bool isTransparent(UVHelper::BlockType blockType) const;
 
     void generateMesh();
     void buildMesh();
 
-    void render(Shader& ourShader);
+    // Meshes a downsampled copy of the chunk, level n merges 2^n blocks per axis
+    void generateLodMesh(int level);
+
+    // Picks the level of detail from the chunk's distance to the camera (in chunks) and keeps
+    // that level's mesh current. The previous level keeps drawing until the new one is ready
+    void updateLod(float distance);
+    int getLodLevel() const;
+
+    void renderSolid(Shader& ourShader);
+    // cameraPos is in chunk local space
+    void renderTransparent(Shader& ourShader, const glm::vec3& cameraPos);
+    bool hasTransparentFaces() const;
 
     int chunkNumberX;
     int chunkNumberZ;
 
+    // Set while the chunk sits in the world's edit queue so it only gets queued once per frame
+    bool queuedForRemesh = false;
+
+    // Edited since it was generated. Untouched chunks are left out of saves, the seed
+    // regenerates them
+    bool modified = false;
+
 private:
-    UVHelper::BlockType ChunkData[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z] = { UVHelper::BlockType::AIR};
+    // Dense blocks, or null while the chunk is stored as column runs. Edits and mesh jobs
+    // need the dense form and decode the runs first
+    struct DenseBlocks {
+        ChunkBlocks blocks;
+    };
+
+    std::unique_ptr<DenseBlocks> ChunkData;
+    std::unique_ptr<ColumnRuns> columns;
+    // Non-null while compressed. Mesh jobs of neighbors read the chunk from worker threads,
+    // so runs replaced by a decode are kept in retiredColumns until no job can still hold them
+    std::atomic<const ColumnRuns*> activeColumns{ nullptr };
+    std::unique_ptr<ColumnRuns> retiredColumns;
+
+    int framesSinceDenseUse = 0;
+    std::atomic<int> compressedReads{ 0 };
+
+    void ensureDense();
+    bool hasJobsInFlight() const;
+
+    // Built after generation and loads, kept current by every edit. Reads never touch the blocks,
+    // so they stay cheap while the chunk is compressed
+    uint8_t heightmaps[Heightmap::TYPE_COUNT][CHUNK_SIZE_X][CHUNK_SIZE_Z] = {};
+
+    void rebuildHeightmaps();
+    void updateHeightmaps(int x, int y, int z, UVHelper::BlockType blockType);
+
+    TerrainGenerator::PendingWrites pendingWrites;
     
     /*unsigned int VAO = 0, VBO = 0, EBO = 0;
 
@@ -42,15 +123,64 @@ private:
     std::vector<unsigned int> indices;*/
 
 
-	std::vector<float> solidVertices;
-	std::vector<unsigned int> solidIndices;
-
-    std::vector<float> transparentVertices;
-	std::vector<unsigned int> transparentIndices;
+    // Written by the mesh job, goes back to the pool once buildMesh has uploaded it
+    std::unique_ptr<MeshArena> meshArena;
 
 	unsigned int solidVAO = 0, solidVBO = 0, solidEBO = 0;
 	unsigned int transparentVAO = 0, transparentVBO = 0, transparentEBO = 0;
+    // Index counts of what is on the GPU, the arena above belongs to the mesh job while it runs
+    int solidDrawCount = 0, transparentDrawCount = 0;
     bool meshBuilding = false;
 
+    // Bumped on every edit; a mesh job remembers the generation it started from so edits
+    // made while it runs trigger another job instead of being dropped
+    unsigned int editGeneration = 0;
+    unsigned int meshingGeneration = 0;
+    unsigned int builtGeneration = 0;
+
     std::future<void> meshFuture;
+
+    void uploadFinishedMesh();
+
+    // Sizes of the last upload per mesh, so the stats totals can swap them out on re-upload
+    int64_t solidUploadedVertices = 0, solidUploadedIndices = 0;
+    int64_t transparentUploadedVertices = 0, transparentUploadedIndices = 0;
+    bool countedAsMeshed = false;
+
+    void countMeshed();
+
+    struct LodMesh {
+        // Only the solid buffers are used, lower levels have no separate transparent mesh
+        std::unique_ptr<MeshArena> arena;
+
+        unsigned int VAO = 0, VBO = 0, EBO = 0;
+        int drawCount = 0;
+
+        unsigned int meshingGeneration = 0;
+        unsigned int builtGeneration = 0;
+        std::future<void> future;
+
+        int64_t uploadedVertices = 0, uploadedIndices = 0;
+    };
+
+    LodMesh lodMeshes[LOD_LEVELS - 1];
+    int lodLevel = 0;
+
+    bool isLodReady(int level) const;
+    void launchMeshJob(int level);
+    void uploadFinishedLodMesh(int level);
+
+    // Transparent faces are sorted back to front on a worker whenever the camera moves into
+    // another block. The mesh job writes the face centers, the upload hands them to the sorter
+    struct TransparentSort {
+        std::shared_ptr<const std::vector<glm::vec3>> faceCenters;
+        std::vector<unsigned int> indices;
+    };
+
+    std::vector<glm::vec3> transparentFaceCenters;
+    std::shared_ptr<const std::vector<glm::vec3>> sortFaceCenters;
+    glm::ivec3 sortedCameraCell = glm::ivec3(0);
+    bool transparentSorted = false;
+
+    std::future<TransparentSort> sortFuture;
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "UVHelper.hpp"
+
+// Swept box collision against the block grid, shared by the player and anything else that
+// moves through the world
+namespace Collision {
+    struct AABB {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct SweepResult {
+        // Displacement that can be applied without entering a block
+        glm::vec3 moved;
+        // Per axis, the direction a blocking face points (+1 on the y axis means standing on
+        // something), zero where the move went through unobstructed
+        glm::ivec3 contactNormal;
+        int voxelsTested;
+    };
+
+    bool isSolid(UVHelper::BlockType blockType);
+    // The box a block at integer coordinates occupies
+    AABB blockBox(const glm::ivec3& blockPos);
+    bool overlaps(const AABB& a, const AABB& b);
+
+    // Moves box by displacement, collecting the blocks in the swept volume once and then
+    // resolving y, x and z in turn. Nothing can tunnel since the whole path is covered
+    SweepResult sweep(const AABB& box, const glm::vec3& displacement);
+}
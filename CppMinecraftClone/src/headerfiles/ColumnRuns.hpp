@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Constants.hpp"
+#include "TerrainGenerator.hpp"
+
+static_assert(CHUNK_SIZE_Y <= 255, "ColumnRuns stores run ends in a byte");
+
+// A chunk stored as runs of identical blocks per column, bottom to top. Generated terrain is a
+// handful of runs per column (stone, dirt, grass, air), so this is a few KB instead of the
+// dense array. Lookups binary search the column
+class ColumnRuns {
+public:
+    struct Run {
+        UVHelper::BlockType type;
+        // First y above the run
+        uint8_t end;
+    };
+
+    void encode(const ChunkBlocks& blocks);
+    void decode(ChunkBlocks& blocks) const;
+
+    // Every column's runs back to back, each column ending at CHUNK_SIZE_Y. Returns false if
+    // they don't describe a whole chunk or name a block type that doesn't exist
+    bool assign(const std::vector<Run>& allRuns);
+    const std::vector<Run>& getRuns() const { return runs; }
+
+    UVHelper::BlockType getBlock(int x, int y, int z) const;
+
+    size_t getByteSize() const;
+
+private:
+    // Index of each column's first run, one extra entry marks the end of the last column
+    std::vector<uint32_t> columnStart;
+    std::vector<Run> runs;
+
+    static int columnIndex(int x, int z) { return x * CHUNK_SIZE_Z + z; }
+};
@@ -7,6 +7,29 @@ constexpr unsigned int CHUNK_SIZE_X = 32;
 constexpr unsigned int CHUNK_SIZE_Y = 255;
 constexpr unsigned int CHUNK_SIZE_Z = 32;
 
+// Level 0 is full detail, each further level halves the voxel resolution
+constexpr int LOD_LEVELS = 4;
+// Chunk distance at which a chunk drops to the next level, a chunk has to move
+// LOD_HYSTERESIS chunks past a threshold before switching so it doesn't flicker
+constexpr float LOD_SWITCH_DISTANCE[LOD_LEVELS - 1] = { 4.0f, 7.0f, 11.0f };
+constexpr float LOD_HYSTERESIS = 0.5f;
+
+// Heightmap rings drawn past the loaded chunks. Every ring is a grid of FAR_TERRAIN_GRID cells
+// per side, and each ring's cells are twice the size of the previous ring's
+constexpr int FAR_TERRAIN_RINGS = 5;
+constexpr int FAR_TERRAIN_GRID = 64;
+constexpr int FAR_TERRAIN_CELL_SIZE = 8;
+
+// Movement and gravity run at a fixed rate, rendering interpolates between the last two ticks.
+// A frame runs at most MAX_SIMULATION_TICKS ticks and drops the rest after a long stall
+constexpr int SIMULATION_TICK_RATE = 60;
+constexpr float SIMULATION_TICK = 1.0f / SIMULATION_TICK_RATE;
+constexpr int MAX_SIMULATION_TICKS = 8;
+
+// Chunk and far terrain vertices are a position, a normal and the block texture array layer.
+// Texture coordinates come from the position in the vertex shader
+constexpr int TERRAIN_VERTEX_FLOATS = 7;
+
 constexpr float vertexData[6][36] = {
     // left face
     {-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AssetManager.hpp"
+#include "Camera.hpp"
+#include "Shader.hpp"
+#include "UVHelper.hpp"
+
+enum class EntityType : uint8_t {
+    ITEM,
+    MOB,
+    PROJECTILE
+};
+
+using EntityId = uint32_t;
+
+// Dynamic objects other than the player. Components are stored as parallel arrays so the
+// per tick passes walk contiguous memory, and a chunk aligned spatial hash answers neighbor
+// queries. Positions are the center of the entity's feet, velocities are in blocks per second
+class EntityWorld {
+public:
+    EntityId spawn(EntityType type, const glm::vec3& position, const glm::vec3& velocity,
+        UVHelper::BlockType block = UVHelper::BlockType::AIR);
+    // Removal is deferred to the end of the next update so ids stay valid during queries
+    void despawn(EntityId id);
+    bool isAlive(EntityId id) const;
+    size_t count() const;
+
+    glm::vec3 getPosition(EntityId id) const;
+    EntityType getType(EntityId id) const;
+    // Seconds since the entity spawned
+    float getAge(EntityId id) const;
+
+    // Advances every entity by one simulation tick
+    void update(float deltaTime);
+
+    // Ids of the entities whose position lies within radius of center
+    void queryRadius(const glm::vec3& center, float radius, std::vector<EntityId>& out) const;
+
+    // Requests the entity shader and sets up the instanced box. Without it render draws nothing,
+    // so simulation-only runs never touch GL
+    void loadAssets(AssetManager& assets);
+    bool isReady() const { return shader && shader->isReady(); }
+    // Draws all entities as instanced boxes, alpha blends between the last two ticks
+    void render(Camera& cam, float alpha);
+
+    ~EntityWorld();
+
+private:
+    // Dense component arrays, index i across all of them is one entity
+    std::vector<EntityId> ids;
+    std::vector<EntityType> types;
+    std::vector<UVHelper::BlockType> blocks;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> previousPositions;
+    std::vector<glm::vec3> velocities;
+    std::vector<float> ages;
+    std::vector<float> wanderTimers;
+    std::vector<uint8_t> grounded;
+
+    // Id to dense index, ids of removed entities are reused
+    std::vector<uint32_t> denseIndex;
+    std::vector<EntityId> freeIds;
+    std::vector<EntityId> pendingDespawns;
+
+    // Dense indices bucketed by chunk column, rebuilt after every update
+    std::unordered_map<int64_t, std::vector<uint32_t>> spatialHash;
+    uint32_t tick = 0;
+
+    void integrate(size_t begin, size_t end, float deltaTime);
+    void collide(size_t begin, size_t end, float deltaTime);
+    void removeAt(uint32_t index);
+    void rebuildSpatialHash();
+
+    std::shared_ptr<ShaderAsset> shader;
+    unsigned int VAO = 0, cubeVBO = 0, instanceVBO = 0;
+    size_t instanceCapacity = 0;
+    std::vector<float> instanceData;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Constants.hpp"
+#include "Shader.hpp"
+
+// Coarse terrain drawn past the loaded chunks, built straight from the heightfield instead
+// of voxel data. Each ring doubles the cell size of the one inside it, so reaching twice as
+// far costs one more ring rather than four times the vertices
+class FarTerrain {
+public:
+    ~FarTerrain();
+
+    // Rebuilds the rings on a worker once the camera has moved far enough to shift one
+    void update(const glm::vec3& cameraPos, int renderDistance);
+    void render(Shader& ourShader);
+
+    // Distance from the camera to the edge of the outermost ring
+    static float getViewDistance();
+
+private:
+    struct Layout {
+        glm::ivec2 ringCenters[FAR_TERRAIN_RINGS];
+        // Area covered by chunks, left empty in the rings
+        glm::ivec2 holeMin;
+        glm::ivec2 holeMax;
+    };
+
+    struct MeshData {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    static bool sameLayout(const Layout& a, const Layout& b);
+    static MeshData buildMesh(const Layout& layout);
+
+    Layout requestedLayout = {};
+    bool hasLayout = false;
+
+    std::future<MeshData> meshFuture;
+
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    int drawCount = 0;
+    int64_t uploadedBytes = 0;
+};
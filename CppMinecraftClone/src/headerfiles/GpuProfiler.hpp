@@ -0,0 +1,41 @@
+#pragma once
+
+// GL_TIME_ELAPSED queries around the main render passes. Every pass owns GPU_TIMER_FRAMES
+// queries used round robin, so a result is only read back once that many frames have
+// passed and never stalls the pipeline. Results go into the profiler trace on a GPU track
+namespace GpuProfiler {
+    constexpr int GPU_TIMER_FRAMES = 3;
+
+    enum Pass {
+        FAR_TERRAIN,
+        SOLID_CHUNKS,
+        TRANSPARENT_CHUNKS,
+        ENTITIES,
+        HIGHLIGHT,
+        HUD,
+        PASS_COUNT
+    };
+
+    void init();
+    void shutdown();
+
+    // Collects the results of the oldest frame and moves on to its queries
+    void beginFrame();
+
+    // Latest GPU time of a pass in milliseconds
+    float getPassTime(Pass pass);
+    const char* getPassName(Pass pass);
+
+    class Scope {
+    public:
+        explicit Scope(Pass pass);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Pass pass;
+        bool active;
+    };
+}
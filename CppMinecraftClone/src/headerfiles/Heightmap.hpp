@@ -0,0 +1,30 @@
+#pragma once
+
+#include "UVHelper.hpp"
+
+// Chunks keep one height per column for each of these, the y above the highest block that
+// counts for it, 0 when the column has none
+namespace Heightmap {
+    enum Type {
+        // Anything collision stops at
+        MOTION_BLOCKING,
+        // Blocks light can't pass, water and leaves let it through
+        OPAQUE,
+        // The ground, trees standing on it don't count
+        SURFACE,
+        TYPE_COUNT
+    };
+
+    inline bool counts(Type type, UVHelper::BlockType block) {
+        switch (type) {
+        case MOTION_BLOCKING:
+            return block != UVHelper::BlockType::AIR;
+        case OPAQUE:
+            return block != UVHelper::BlockType::AIR && block != UVHelper::BlockType::WATER && block != UVHelper::BlockType::OAKLEAVES;
+        case SURFACE:
+            return block != UVHelper::BlockType::AIR && block != UVHelper::BlockType::OAKLEAVES && block != UVHelper::BlockType::OAKLOG;
+        default:
+            return false;
+        }
+    }
+}
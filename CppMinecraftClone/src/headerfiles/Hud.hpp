@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "AssetManager.hpp"
+
+// Crosshair, hotbar frames and hotbar icons as instanced quads in one persistent buffer.
+// The buffer is only rewritten when the selected slot changes and the whole HUD is one draw
+class Hud {
+public:
+    explicit Hud(AssetManager& assets);
+    ~Hud();
+
+    Hud(const Hud&) = delete;
+    Hud& operator=(const Hud&) = delete;
+
+    bool isReady() const { return shader->isReady(); }
+    // Expects the block texture array on texture unit 0
+    void render(int selectedSlot);
+
+private:
+    std::shared_ptr<ShaderAsset> shader;
+    unsigned int VAO = 0, instanceVBO = 0;
+
+    std::vector<float> instances;
+    int instanceCount = 0;
+    int builtSlot = -1;
+
+    void buildInstances(int selectedSlot);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include <GLFW/glfw3.h>
+
+// Everything the simulation reads from the user during one frame. Game code reads keys and
+// mouse events from here instead of asking GLFW, so a recorded run replays identically
+struct InputFrame {
+    float deltaTime = 0.0f;
+
+    // One bit per entry of TRACKED_KEYS
+    uint32_t keys = 0;
+
+    bool cursorMoved = false;
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    double scroll = 0.0;
+
+    bool leftClick = false;
+    bool rightClick = false;
+
+    bool isKeyDown(int key) const;
+};
+
+class InputSource {
+public:
+    ~InputSource();
+
+    // Window callbacks collect events here between frames. Ignored while replaying
+    void onCursor(double x, double y);
+    void onScroll(double yoffset);
+    void onMouseButton(int button, int action);
+
+    // Every frame handed out from now on is appended to the file
+    bool startRecording(const std::string& path);
+    // Frames come from the file instead of the window until it runs out
+    bool startReplay(const std::string& path);
+
+    bool isReplaying() const;
+    bool replayFinished() const;
+
+    // Polls the window, or reads the next recorded frame when replaying. A recorded frame
+    // keeps its own delta time unless fixedDeltaTime is above zero
+    InputFrame nextFrame(GLFWwindow* window, float deltaTime, float fixedDeltaTime = 0.0f);
+
+private:
+    InputFrame pending;
+
+    std::ofstream recordFile;
+    std::ifstream replayFile;
+    bool replaying = false;
+    bool finished = false;
+
+    bool readFrame(InputFrame& frame);
+    void writeFrame(const InputFrame& frame);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "UVHelper.hpp"
+
+// Scratch buffers a chunk mesh job builds into. The chunk holds on to its arena only until the
+// mesh is on the GPU and then hands it back to a shared pool. Pooled arenas keep their
+// capacity, so once the pool has warmed up meshing no longer allocates vertex memory
+struct MeshArena {
+    std::vector<float> solidVertices;
+    std::vector<unsigned int> solidIndices;
+    std::vector<float> transparentVertices;
+    std::vector<unsigned int> transparentIndices;
+
+    // Downsampled cells and column tops of level of detail meshes
+    std::vector<UVHelper::BlockType> lodCells;
+    std::vector<int> lodColumnTops;
+
+    // Makes room for this many faces up front, the vectors never shrink
+    void reserveFaces(size_t solidFaces, size_t transparentFaces);
+    void clear();
+    size_t getByteSize() const;
+
+    // Capacity last added to Stats::meshCpuBytes
+    size_t countedBytes = 0;
+};
+
+namespace MeshArenas {
+    // A cleared arena from the pool, or a new one when every pooled arena is taken. Safe to
+    // call from mesh jobs
+    std::unique_ptr<MeshArena> acquire();
+    // Returns an arena whose mesh has been uploaded. Past the pool's capacity it is freed instead
+    void release(std::unique_ptr<MeshArena> arena);
+
+    int getPooledCount();
+}
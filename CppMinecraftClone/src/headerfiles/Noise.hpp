@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// All noise and random numbers used by world generation go through here, so the world seed
+// alone reproduces a world. Every field has its own channel, which keeps fields sampled at
+// the same position independent of each other
+namespace Noise {
+    enum Channel {
+        HEIGHT,
+        OVERHANGS,
+        CAVE_A,
+        CAVE_B,
+        TEMPERATURE,
+        HUMIDITY,
+        ORES,
+        TREES,
+        CHANNEL_COUNT
+    };
+
+    // Set before generation starts. The channels are read by the generator threads without
+    // synchronization
+    void setSeed(uint64_t seed);
+    uint64_t getSeed();
+
+    // stb_perlin 3D noise, coordinates already scaled by the field's frequency. The seed
+    // picks one of stb's permutations and shifts the lattice per channel
+    float perlin(Channel channel, float x, float y, float z);
+
+    // Seed for a random stream that belongs to one chunk
+    uint32_t chunkSeed(Channel channel, int chunkX, int chunkZ);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+// Minimal PNG encoder for frame dumps. The image data goes into stored (uncompressed)
+// deflate blocks, which keeps it dependency free at the cost of file size
+namespace PngWriter {
+    // pixels holds tightly packed RGB rows. OpenGL returns rows bottom up, flipVertically
+    // turns them the right way round
+    bool writeRgb(const std::string& path, int width, int height, const unsigned char* pixels, bool flipVertically);
+}
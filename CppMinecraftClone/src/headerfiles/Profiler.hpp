@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Scoped CPU timing zones. Finished zones go into a fixed size ring buffer that can be
+// written out as Chrome trace_event JSON (open it in chrome://tracing or Perfetto).
+// Off by default, while disabled a zone costs a single relaxed atomic load. Recording threads
+// claim ring slots with an atomic counter and never take a lock
+namespace Profiler {
+    constexpr unsigned int RING_CAPACITY = 1 << 16;
+
+    extern std::atomic<bool> enabled;
+
+    void setEnabled(bool enable);
+    bool isEnabled();
+
+    // Nanoseconds since the profiler started
+    uint64_t now();
+
+    // Small id per thread, zones are attributed to the thread that closed them
+    uint32_t currentThreadId();
+    void setThreadName(const char* name);
+
+    void record(const char* name, uint64_t startNs, uint64_t durationNs);
+    // Same as record but lands on a separate GPU track in the trace
+    void recordGpu(const char* name, uint64_t startNs, uint64_t durationNs);
+    bool dumpChromeTrace(const char* path);
+
+    class Zone {
+    public:
+        explicit Zone(const char* zoneName) :
+            name(zoneName),
+            active(enabled.load(std::memory_order_relaxed)),
+            startNs(active ? now() : 0)
+        {
+        }
+
+        ~Zone() {
+            if (active) record(name, startNs, now() - startNs);
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* name;
+        bool active;
+        uint64_t startNs;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// name has to outlive the trace, in practice a string literal
+#define PROFILE_ZONE(name) Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
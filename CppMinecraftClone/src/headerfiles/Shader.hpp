@@ -7,17 +7,43 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+struct ShaderSource {
+    std::string vertex;
+    std::string fragment;
+};
+
+// Programs load from a binary cache keyed by source and driver when the driver supports it.
+// Otherwise compiling starts in the constructor and is only waited on by the first use()
 class Shader {
 public:
     unsigned int ID;
     Shader(const char* vertexPath, const char* fragmentPath);
+    explicit Shader(const ShaderSource& source);
     ~Shader();
 
-    void use() const;
+    static bool readSource(const std::string& vertexPath, const std::string& fragmentPath, ShaderSource& source);
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    void use();
+    // Waits for the link if it is still running
+    bool isLinked();
 
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
     void setFloat(const std::string& name, float value) const;
+    void setVec2(const std::string& name, const glm::vec2& value) const;
     void setVec3(const std::string& name, glm::vec3& value) const;
     void setMatrix(const std::string& name, const glm::mat4& value) const;
+
+private:
+    unsigned int vertexShader = 0, fragmentShader = 0;
+    bool linkPending = false;
+    bool linked = false;
+    std::string cachePath;
+
+    void build(const ShaderSource& source);
+    // Checks compile and link status and stores the binary in the cache
+    void finishLink();
 };
\ No newline at end of file
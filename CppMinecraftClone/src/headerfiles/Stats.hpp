@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Engine counters shown by the stats overlay. Everything is atomic because mesh and
+// generation jobs update them from worker threads
+namespace Stats {
+    // Running totals
+    extern std::atomic<int> chunksLoaded;
+    extern std::atomic<int> chunksMeshed;
+    extern std::atomic<int> chunksCompressed;
+    extern std::atomic<int> meshJobsInFlight;
+
+    extern std::atomic<int> entityCount;
+    extern std::atomic<int64_t> entityUpdateNs;
+
+    extern std::atomic<int64_t> gpuVertices;
+    extern std::atomic<int64_t> gpuIndices;
+
+    // Bytes held per subsystem
+    extern std::atomic<int64_t> voxelBytes;
+    extern std::atomic<int64_t> meshCpuBytes;
+    extern std::atomic<int64_t> meshGpuBytes;
+    extern std::atomic<int64_t> farTerrainBytes;
+
+    // Reset by endFrame
+    extern std::atomic<int> chunksDrawn;
+    extern std::atomic<int> chunksCulled;
+    extern std::atomic<int> drawCalls;
+    extern std::atomic<int64_t> bytesUploaded;
+
+    struct FrameCounters {
+        int chunksDrawn = 0;
+        int chunksCulled = 0;
+        int drawCalls = 0;
+        int64_t bytesUploaded = 0;
+    };
+
+    // Stores the frame time, snapshots the per frame counters and zeroes them
+    void endFrame(float frameSeconds);
+    const FrameCounters& lastFrame();
+
+    // Percentile (0 - 100) over the recent frame times, in milliseconds
+    float frameTimePercentile(float percentile);
+
+    // Resident set size of the whole process, 0 where the platform query isn't available
+    size_t processResidentBytes();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "TextRenderer.hpp"
+
+// Debug panel in the top left corner with frame time percentiles, GPU pass times and the
+// engine counters from Stats
+class StatsOverlay {
+public:
+    explicit StatsOverlay(AssetManager& assets) : text(assets) {}
+
+    bool isReady() const { return text.isReady(); }
+    void render(int screenWidth, int screenHeight);
+
+private:
+    TextRenderer text;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Biomes.hpp"
+#include "BlockLayout.hpp"
+#include "Constants.hpp"
+#include "UVHelper.hpp"
+
+// Fills a chunk in separate passes over its block buffer, each timed on its own. Climate
+// picks the biomes and height of every column, density shapes stone from those heights plus
+// 3D noise for overhangs, surface covers every column with its biome's blocks, carvers cut
+// caves, ores place veins in stone and decoration grows trees. 3D noise is sampled on a
+// coarse lattice and interpolated in between
+namespace TerrainGenerator {
+    // Bump whenever a change makes the same seed generate different blocks. Saves record it,
+    // since they rely on regenerating every chunk they don't store
+    constexpr uint32_t GENERATION_VERSION = 1;
+
+    enum Stage {
+        CLIMATE,
+        DENSITY,
+        SURFACE,
+        CARVERS,
+        ORES,
+        DECORATION,
+        STAGE_COUNT
+    };
+
+    // A block placed by a structure, in the target chunk's local coordinates
+    struct StructureWrite {
+        int x, y, z;
+        UVHelper::BlockType type;
+    };
+
+    // Structure blocks that landed outside the chunk being generated, kept per neighbor until
+    // that neighbor's terrain exists. Indexed by the neighbor's chunk offset + 1 on each axis
+    struct PendingWrites {
+        std::vector<StructureWrite> neighbors[3][3];
+    };
+
+    // Safe to call from several threads for different chunks. Never touches other chunks,
+    // whatever crosses the border goes into outgoing
+    void generate(int chunkX, int chunkZ, ChunkBlocks& blocks, PendingWrites& outgoing);
+
+    // Structure blocks only replace air, and logs replace leaves. Which block ends up in a
+    // spot doesn't depend on the order writes arrive in. Returns how many blocks changed
+    int applyWrites(ChunkBlocks& blocks, const std::vector<StructureWrite>& writes);
+
+    float fbm(float x, float z);
+    // Column height of the height field at a world position, the top block sits at height - 1.
+    // Overhangs and caves make the generated column differ from it by a few blocks
+    int terrainHeight(float x, float z, const Biomes::ColumnClimate& column);
+    // Same, for a one off lookup that samples the climate itself
+    int terrainHeight(float x, float z);
+
+    const char* getStageName(Stage stage);
+    // Average milliseconds per generated chunk
+    double getStageTime(Stage stage);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AssetManager.hpp"
+
+// Batches screen space rectangles and text into one dynamic buffer and draws them with a
+// single call. Text uses a built in 5x7 font, positions and sizes are in pixels from the
+// top left corner
+class TextRenderer {
+public:
+    explicit TextRenderer(AssetManager& assets);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    bool isReady() const { return shader->isReady(); }
+
+    void begin(int screenWidth, int screenHeight);
+    void addRect(float x, float y, float width, float height, const glm::vec4& color);
+    void addText(float x, float y, const std::string& text, const glm::vec4& color, float scale = 2.0f);
+    // Draws everything added since begin
+    void flush();
+
+    static float textWidth(const std::string& text, float scale = 2.0f);
+    static float lineHeight(float scale = 2.0f);
+
+private:
+    std::shared_ptr<ShaderAsset> shader;
+    unsigned int VAO = 0, VBO = 0, fontTexture = 0;
+    size_t bufferCapacity = 0;
+
+    std::vector<float> vertices;
+    float pixelToNdcX = 0.0f, pixelToNdcY = 0.0f;
+
+    void addQuad(float x, float y, float width, float height, float u0, float v0, float u1, float v1, const glm::vec4& color);
+};
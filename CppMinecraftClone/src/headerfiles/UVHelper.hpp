@@ -10,7 +10,10 @@ namespace UVHelper {
         STONE,
         OAKLOG,
         OAKLEAVES,
-        WATER
+        WATER,
+        COAL_ORE,
+        IRON_ORE,
+        SAND
     };
 
     struct BlockUV {
@@ -27,13 +30,16 @@ namespace UVHelper {
         { 4, 4, 4 }, // STONE
         { 2, 6, 2 }, // OAK LOG
         { 5, 5, 5 }, // OAK LEAVES
-        { 7, 7, 7 } // WATER
+        { 7, 7, 7 }, // WATER
+        { 9, 9, 9 }, // COAL ORE
+        { 10, 10, 10 }, // IRON ORE
+        { 8, 8, 8 } // SAND
     };
 
-    struct UVCoords {
-        float uMin, vMin;
-        float uMax, vMax;
-    };
+    // The atlas image is a grid of square tiles, each one becomes a layer of the block texture array
+    constexpr int ATLAS_TILES_PER_ROW = 3;
+    constexpr int ATLAS_TILE_SIZE = 16;
 
-    UVCoords getUVCoords(int tileIndex, int tilesPerRow, int tileSize, int atlasSize);
+    // Texture array layer for one face of a block, faces are ordered as in vertexData
+    int getTileLayer(BlockType type, int face);
 }
\ No newline at end of file
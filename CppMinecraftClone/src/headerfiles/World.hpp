@@ -7,4 +7,22 @@
 extern Chunk chunks[WORLD_SIZE_X][WORLD_SIZE_Z];
 
 void generateWorld();
-void renderWorld(Shader& ourShader);
+// Generates and then meshes every chunk on the calling thread, rounds times over, and prints the
+// time per chunk of both for the block layout the build uses
+void benchmarkChunks(int rounds);
+// Lets every chunk switch between dense and column run storage, once per frame
+void updateChunkStorage();
+// Draws every chunk within renderDistance of the camera, solid geometry first and then
+// the transparent meshes sorted back to front
+void renderWorld(Shader& ourShader, const glm::vec3& cameraPos, int renderDistance);
+
+// World space block access. setBlock only queues the affected chunks, flushEdits
+// schedules a single remesh per dirty chunk and should be called once per frame
+UVHelper::BlockType getWorldBlock(int x, int y, int z);
+// One above the highest block of the column that counts for the heightmap, 0 outside the world
+int getWorldHeight(int x, int z, Heightmap::Type type);
+// Same for a position, blocks span +-0.5 around integer coordinates so it rounds to the nearest column
+int getWorldHeightAt(float x, float z, Heightmap::Type type);
+void setBlock(int x, int y, int z, UVHelper::BlockType blockType);
+void markChunkDirty(int chunkX, int chunkZ);
+void flushEdits();
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "UVHelper.hpp"
+
+// Region edits that work a chunk row at a time instead of per voxel. Corners are
+// inclusive world coordinates in any order, anything outside the world is clipped.
+// Every touched chunk is queued once, the remesh happens on the next flushEdits
+namespace WorldEdit {
+    struct Clipboard {
+        glm::ivec3 size = glm::ivec3(0);
+        // Same x, y, z nesting as chunk storage so rows copy straight across
+        std::vector<UVHelper::BlockType> blocks;
+    };
+
+    void fill(glm::ivec3 cornerA, glm::ivec3 cornerB, UVHelper::BlockType blockType);
+    int replace(glm::ivec3 cornerA, glm::ivec3 cornerB, UVHelper::BlockType from, UVHelper::BlockType to);
+
+    Clipboard copy(glm::ivec3 cornerA, glm::ivec3 cornerB);
+    void paste(const Clipboard& clipboard, glm::ivec3 origin, bool skipAir = false);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// World files hold the seed, the generation version and only the chunks that were edited.
+// Everything else is regenerated from the seed on load. Edited chunks are stored as the
+// column runs of ColumnRuns
+namespace WorldSave {
+    struct Header {
+        uint32_t generationVersion = 0;
+        uint64_t seed = 0;
+        uint32_t chunkCount = 0;
+    };
+
+    // Reads just the header, so the seed can be set before the world is generated
+    bool readHeader(const std::string& path, Header& header);
+    // Copies the stored chunks over the generated world, call once generateWorld is done
+    bool loadChunks(const std::string& path);
+    bool save(const std::string& path);
+}
@@ -1,7 +1,11 @@
-#define STB_IMAGE_IMPLEMENTATION
-#include "includes/stb_image.h"
-
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -18,23 +22,81 @@
 #include "headerfiles/World.hpp"
 #include "headerfiles/Shader.hpp"
 #include "headerfiles/Player.hpp"
+#include "headerfiles/FarTerrain.hpp"
+#include "headerfiles/Profiler.hpp"
+#include "headerfiles/GpuProfiler.hpp"
+#include "headerfiles/Stats.hpp"
+#include "headerfiles/StatsOverlay.hpp"
+#include "headerfiles/Input.hpp"
+#include "headerfiles/CameraPath.hpp"
+#include "headerfiles/PngWriter.hpp"
+#include "headerfiles/EntityWorld.hpp"
+#include "headerfiles/Hud.hpp"
+#include "headerfiles/AssetManager.hpp"
+#include "headerfiles/Noise.hpp"
+#include "headerfiles/WorldSave.hpp"
+#include "headerfiles/WorldEdit.hpp"
+
+struct LaunchOptions {
+    std::string recordPath;
+    std::string replayPath;
+    std::string timingLogPath;
+    // Overrides every frame's delta time when above zero
+    float fixedDeltaTime = 0.0f;
+
+    // Offscreen context with no window, the camera follows a scripted path
+    bool headless = false;
+    std::string cameraPathFile;
+    int frameLimit = 0;
+    int spawnEntities = 0;
+    std::string dumpFramesPrefix;
+    int dumpInterval = 60;
+
+    // A world file that exists brings its own seed, otherwise worldSeed is used and the
+    // world is written there on exit
+    std::string worldPath;
+    uint64_t worldSeed = 0;
+
+    // Times generating and meshing the whole world this many times, then exits
+    int chunkBenchmarkRounds = 0;
+
+    // Records profiler zones from the start instead of waiting for F8
+    bool profile = false;
+};
 
 struct AppState {
     Camera cam;
     Player player;
+    InputSource input;
+    EntityWorld entities;
 
     bool spacePressedLastFrame = false;
+    bool profileTogglePressedLastFrame = false;
+    bool profileDumpPressedLastFrame = false;
+    bool statsPressedLastFrame = false;
+    bool dropPressedLastFrame = false;
+    bool firePressedLastFrame = false;
+    bool fillPressedLastFrame = false;
+    bool replacePressedLastFrame = false;
+    bool copyPressedLastFrame = false;
+    bool pastePressedLastFrame = false;
+    bool showStats = false;
     bool firstSpaceTap = false;
     float lastSpaceTapTime = 0.0f;
 
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
+    // Sum of simulated delta times, stays in step with a replay unlike the wall clock
+    float simulationTime = 0.0f;
+    // Frame time not yet consumed by simulation ticks
+    float simulationAccumulator = 0.0f;
+    bool sprinting = false;
+    float entityAlpha = 0.0f;
 
-    unsigned int invSlotVAOs[9];
-    unsigned int invSlotVBOs[9];
-
-    unsigned int uiSlotVAOs[6];
-    unsigned int uiSlotVBOs[6];
+    // World edit selection, alt + left and right click set its two corners
+    glm::ivec3 selectionCorners[2] = { glm::ivec3(0), glm::ivec3(0) };
+    bool selectionCornerSet[2] = { false, false };
+    WorldEdit::Clipboard clipboard;
 
     AppState(GLFWwindow* window) :
         cam(window, player)
@@ -44,19 +106,31 @@ struct AppState {
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
-void processInput(AppState& app, GLFWwindow* window);
+void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+bool parseLaunchOptions(int argc, char** argv, LaunchOptions& options);
+GLFWwindow* createHeadlessWindow();
+void dumpFrame(const std::string& prefix, int frameNumber);
+void processInput(AppState& app, GLFWwindow* window, const InputFrame& input);
+void handleClick(AppState& app, int button);
+void handleWorldEdit(AppState& app, const InputFrame& input);
+void scatterEntities(EntityWorld& entities, int count);
+void collectNearbyItems(AppState& app);
 
-unsigned int loadTexture(const char* path);
 
-void crosshairSetUp(unsigned int& VAO, unsigned int& VBO);
-void updateSlots(AppState& app);
-void invSlotSetUp(unsigned int& VAO, unsigned int& VBO, int index, bool selected);
-void uiSlotSetUp(unsigned int& VAO, unsigned int& VBO, int index);
 void highlightBlockSetUp(unsigned int& VAO, unsigned int& VBO);
 //
 
-int main(void)
+int main(int argc, char** argv)
 {
+    LaunchOptions options;
+    if (!parseLaunchOptions(argc, argv, options)) return -1;
+
+    // The null platform needs no display, the context comes from EGL or OSMesa instead
+    if (options.headless) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+
     // Initialize GLFW
     if (!glfwInit()) return -1;
 
@@ -64,24 +138,44 @@ int main(void)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    std::cout << "Double click the spacebar to toggle spectator/survival mode\n" << std::endl;
+    std::cout << "Double click the spacebar to toggle spectator/survival mode" << std::endl;
+    std::cout << "Press F3 to toggle the stats overlay" << std::endl;
+    std::cout << "Press Q to drop the held block and F to fire a projectile" << std::endl;
+    std::cout << "Alt + left/right click marks a selection. G fills it with the held block, R replaces the\n"
+        << "targeted block's type in it with the held block, C copies it and V pastes at the targeted face" << std::endl;
+    std::cout << "Press F8 to start or stop recording profiler zones and F9 to write the last ones to\n"
+        << "profile_trace.json, --profile records from startup\n" << std::endl;
+
+    Profiler::setThreadName("Main");
+    Profiler::setEnabled(options.profile);
 
     // Create Window
-    GLFWmonitor* primary = glfwGetPrimaryMonitor();
-    const GLFWvidmode* mode = glfwGetVideoMode(primary);
-    GLFWwindow* window = glfwCreateWindow(mode->width, mode->height, "Minecraft Clone", primary, NULL);
-    AppState app(window);
+    GLFWwindow* window = NULL;
+    if (options.headless) {
+        window = createHeadlessWindow();
+    }
+    else {
+        GLFWmonitor* primary = glfwGetPrimaryMonitor();
+        const GLFWvidmode* mode = glfwGetVideoMode(primary);
+        window = glfwCreateWindow(mode->width, mode->height, "Minecraft Clone", primary, NULL);
+    }
     if (!window)
     {
         glfwTerminate();
         return -1;
     }
+    AppState app(window);
 
     glfwMakeContextCurrent(window);
     glfwSetWindowUserPointer(window, &app);
     //glfwSwapInterval(0);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetCursorPosCallback(window, cursor_pos_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+
+    if (!options.replayPath.empty() && !app.input.startReplay(options.replayPath)) return -1;
+    if (!options.recordPath.empty() && !app.input.startRecording(options.recordPath)) return -1;
 
     // Load OpenGL functions
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -89,6 +183,8 @@ int main(void)
         return -1;
     }
    
+    GpuProfiler::init();
+
     glEnable(GL_DEPTH_TEST);
     
     glEnable(GL_BLEND);
@@ -98,155 +194,273 @@ int main(void)
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
 
-    unsigned int textureAtlas;
+    // Generation depends on nothing but the seed, so a save only has to carry that and its edited chunks
+    bool loadWorld = !options.worldPath.empty() && std::ifstream(options.worldPath).good();
+    uint64_t worldSeed = options.worldSeed;
+    if (loadWorld) {
+        WorldSave::Header savedWorld;
+        if (!WorldSave::readHeader(options.worldPath, savedWorld)) return -1;
+        worldSeed = savedWorld.seed;
+    }
+    Noise::setSeed(worldSeed);
+    std::cout << "World seed " << worldSeed << std::endl;
 
-    textureAtlas = loadTexture("src/shaders/resources/textureatlasmcclone.png");
+    if (options.chunkBenchmarkRounds > 0) {
+        benchmarkChunks(options.chunkBenchmarkRounds);
+        glfwTerminate();
+        return 0;
+    }
 
-    // -----------
-    Shader ourShader("src/shaders/vs/vertexShader.vs", "src/shaders/fs/fragmentShader.fs");
+    // The world generates on a worker while the assets load on others
+    std::future<void> worldGeneration = std::async(std::launch::async, generateWorld);
+
+    AssetManager assets;
+    std::shared_ptr<TextureArrayAsset> blockTextures = assets.loadTextureArray("src/shaders/resources/textureatlasmcclone.png",
+        UVHelper::ATLAS_TILE_SIZE, UVHelper::ATLAS_TILES_PER_ROW);
+    std::shared_ptr<ShaderAsset> terrainProgram = assets.loadShader("src/shaders/vs/vertexShader.vs", "src/shaders/fs/fragmentShader.fs");
+    std::shared_ptr<ShaderAsset> highlightProgram = assets.loadShader("src/shaders/vs/highlight.vs", "src/shaders/fs/highlight.fs");
+
+    // Also runs after every hot reload of the terrain shader
+    terrainProgram->onLoad = [](Shader& ourShader) {
+        ourShader.use();
+        ourShader.setInt("textureVal", 0);
 
-    ourShader.use();
-    ourShader.setInt("textureVal", 0);
+        glm::vec3 objectColor(1.0f, 1.0f, 1.0f);
+        glm::vec3 lightColor(0.8f, 0.8f, 0.7f);
+        glm::vec3 lightDir(-0.2f, -1.0f, -0.3f);
 
-    glm::vec3 objectColor(1.0f, 1.0f, 1.0f);
-    glm::vec3 lightColor(0.8f, 0.8f, 0.7f);
-    glm::vec3 lightDir(-0.2f, -1.0f, -0.3f);
+        ourShader.setVec3("objectColor", objectColor);
+        ourShader.setVec3("lightColor", lightColor);
+        ourShader.setVec3("lightDir", lightDir);
+    };
 
-    ourShader.setVec3("objectColor", objectColor);
-    ourShader.setVec3("lightColor", lightColor);
-    ourShader.setVec3("lightDir", lightDir);
+    // Crosshair and hotbar
+    Hud hud(assets);
+    // --------------------
 
+    unsigned int highlightVAO, highlightVBO;
 
-    // Set up crosshair
-    Shader crosshairShader("src/shaders/vs/crosshair.vs", "src/shaders/fs/crosshair.fs");
-    unsigned int crossVAO, crossVBO;
+    highlightBlockSetUp(highlightVAO, highlightVBO);
+    // -------------
 
-    crosshairSetUp(crossVAO, crossVBO);
+    FarTerrain farTerrain;
+    StatsOverlay statsOverlay(assets);
+    app.entities.loadAssets(assets);
 
-    // Set up invSlot
-    Shader invSlotShader("src/shaders/vs/invslot.vs", "src/shaders/fs/invslot.fs");
+    assets.finishLoading();
 
-    for (int i = 0; i < 9; ++i) {
-        unsigned int invSlotVAO, invSlotVBO;
-        invSlotSetUp(invSlotVAO, invSlotVBO, i, i == app.player.currentInventorySlot);
-        app.invSlotVAOs[i] = invSlotVAO;
-        app.invSlotVBOs[i] = invSlotVBO;
+    // Every frame draws with these, a file that failed to load ends startup here instead
+    if (!blockTextures->isReady() || !terrainProgram->isReady() || !highlightProgram->isReady() ||
+        !hud.isReady() || !statsOverlay.isReady() || !app.entities.isReady()) {
+        std::cout << "ERROR::ASSETS::STARTUP_ASSETS_MISSING" << std::endl;
+        glfwTerminate();
+        return -1;
     }
-    
-    // Set up inventory slot icons
-    Shader uiSlotShader("src/shaders/vs/uislot.vs", "src/shaders/fs/uislot.fs");
-    ourShader.setInt("textureVal", 0);
-    
-    for (int i = 0; i < 6; ++i) {
-        unsigned int uiSlotVAO, uiSlotVBO;
-        uiSlotSetUp(uiSlotVAO, uiSlotVBO, i);
-        app.uiSlotVAOs[i] = uiSlotVAO;
-        app.uiSlotVBOs[i] = uiSlotVBO;
+
+    worldGeneration.get();
+
+    if (loadWorld && !WorldSave::loadChunks(options.worldPath)) return -1;
+
+    app.cam.placeOnGround();
+    scatterEntities(app.entities, options.spawnEntities);
+
+    // Per frame timings for comparing runs, one row per frame
+    std::ofstream timingLog;
+    if (!options.timingLogPath.empty()) {
+        timingLog.open(options.timingLogPath);
+        timingLog << "frame,sim_dt_ms,cpu_frame_ms,draw_calls,uploaded_bytes";
+        for (int pass = 0; pass < GpuProfiler::PASS_COUNT; ++pass) {
+            timingLog << "," << GpuProfiler::getPassName(static_cast<GpuProfiler::Pass>(pass)) << " ms";
+        }
+        timingLog << "\n";
     }
-    // --------------------
+    int frameNumber = 0;
 
-    Shader highlightShader("src/shaders/vs/highlight.vs", "src/shaders/fs/highlight.fs");
-    unsigned int highlightVAO, highlightVBO;
+    // Headless runs follow a camera path unless a replay drives the camera
+    bool followPath = options.headless && !app.input.isReplaying();
+    CameraPath cameraPath = CameraPath::flyover();
+    if (followPath) {
+        if (!options.cameraPathFile.empty() && !cameraPath.load(options.cameraPathFile)) return -1;
 
-    highlightBlockSetUp(highlightVAO, highlightVBO);
-    // -------------
+        // Spectator mode so gravity doesn't fight the path
+        app.player.physicalState = false;
+    }
 
-    generateWorld();
+    std::vector<float> cpuFrameTimes;
+    int64_t totalDrawCalls = 0;
+    int64_t totalUploadedBytes = 0;
 
     while (!glfwWindowShouldClose(window))
     {
+        PROFILE_ZONE("Frame");
+        GpuProfiler::beginFrame();
+
+        // Hot reloads replace programs, so they are looked up every frame
+        assets.update();
+        Shader& ourShader = terrainProgram->get();
+        Shader& highlightShader = highlightProgram->get();
+
         float time = glfwGetTime();
-        app.deltaTime = time - app.lastFrame;
+        float realDeltaTime = time - app.lastFrame;
         app.lastFrame = time;
 
-        float fps = 1.0f / app.deltaTime;
+        InputFrame input = app.input.nextFrame(window, realDeltaTime, options.fixedDeltaTime);
+        if (app.input.replayFinished()) {
+            glfwSetWindowShouldClose(window, true);
+            break;
+        }
+        app.deltaTime = input.deltaTime;
+        app.simulationTime += input.deltaTime;
+
+        processInput(app, window, input);
+
+        {
+            PROFILE_ZONE("Simulation");
+
+            app.simulationAccumulator += input.deltaTime;
+            int ticks = 0;
+            while (app.simulationAccumulator >= SIMULATION_TICK && ticks < MAX_SIMULATION_TICKS) {
+                app.cam.processCameraInput(input, SIMULATION_TICK, app.sprinting);
+                app.entities.update(SIMULATION_TICK);
+                collectNearbyItems(app);
+                app.simulationAccumulator -= SIMULATION_TICK;
+                ++ticks;
+            }
+            // Hit the tick cap with whole ticks still due, drop them instead of catching up later
+            if (app.simulationAccumulator >= SIMULATION_TICK) {
+                app.simulationAccumulator = 0.0f;
+            }
+            app.cam.interpolate(app.simulationAccumulator / SIMULATION_TICK);
+            app.entityAlpha = app.simulationAccumulator / SIMULATION_TICK;
+        }
+
+        if (followPath) {
+            if (app.simulationTime > cameraPath.duration()) {
+                glfwSetWindowShouldClose(window, true);
+                break;
+            }
+
+            CameraPath::Keyframe pose = cameraPath.sample(app.simulationTime);
+            app.cam.setPose(pose.position, pose.yaw, pose.pitch);
+        }
+        flushEdits();
+        updateChunkStorage();
 
-        processInput(app, window);
         glClearColor(0.2f, 0.3f, 0.3f, 1);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Bind Texture
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureAtlas);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, blockTextures->getId());
 
         // Use Shaders
         ourShader.use();
-        app.cam.setProjection(ourShader);
         app.cam.setCamera(ourShader);
 
-        int playerChunkX = app.cam.getCamPos().x / CHUNK_SIZE_X;
-        int playerChunkZ = app.cam.getCamPos().z / CHUNK_SIZE_Z;
+        // Far terrain gets its own depth range, chunks are drawn over it afterwards
+        {
+            PROFILE_ZONE("FarTerrain");
+            GpuProfiler::Scope gpuTimer(GpuProfiler::FAR_TERRAIN);
 
-        int renderBoundXLeft = std::max(0, playerChunkX - app.player.renderDistance);
-        int renderBoundXRight = std::min((int)WORLD_SIZE_X, playerChunkX + app.player.renderDistance + 1);
-        int renderBoundZLeft = std::max(0, playerChunkZ - app.player.renderDistance);
-        int renderBoundZRight = std::min((int)WORLD_SIZE_Z, playerChunkZ + app.player.renderDistance + 1);
+            farTerrain.update(app.cam.getCamPos(), app.player.renderDistance);
+            app.cam.setProjection(ourShader, 1.0, FarTerrain::getViewDistance() * 1.5);
+            farTerrain.render(ourShader);
+            glClear(GL_DEPTH_BUFFER_BIT);
+        }
 
-        for (int chunkRow = renderBoundXLeft; chunkRow < renderBoundXRight; chunkRow++) {
-            for (int chunkCell = renderBoundZLeft; chunkCell < renderBoundZRight; chunkCell++) {
-                glm::mat4 model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3(chunkRow * CHUNK_SIZE_X, 0, chunkCell * CHUNK_SIZE_Z));
-                ourShader.setMatrix("model", model);
+        app.cam.setProjection(ourShader);
 
-                Chunk& chunk = chunks[chunkRow][chunkCell];
-                chunk.render(ourShader);
-            }
+        // Entities go first so water drawn in the transparent pass blends over them
+        {
+            GpuProfiler::Scope gpuTimer(GpuProfiler::ENTITIES);
+            app.entities.render(app.cam, app.entityAlpha);
         }
 
+        ourShader.use();
+        renderWorld(ourShader, app.cam.getCamPos(), app.player.renderDistance);
+
         // Highlight if looking at a block
-        highlightBlock(app.cam, highlightShader, highlightVAO);
+        {
+            GpuProfiler::Scope gpuTimer(GpuProfiler::HIGHLIGHT);
+            highlightBlock(app.cam, highlightShader, highlightVAO);
+        }
 
-        // Cross hair
-        glDisable(GL_DEPTH_TEST);
+        {
+            PROFILE_ZONE("HUD");
 
-        crosshairShader.use();
-        glBindVertexArray(crossVAO);
+            glDisable(GL_DEPTH_TEST);
 
-        glLineWidth(2.0f);
-        glDrawArrays(GL_LINES, 0, 4);
-        glBindVertexArray(0);
-        // -------------------------
+            GpuProfiler::Scope gpuTimer(GpuProfiler::HUD);
+            hud.render(app.player.currentInventorySlot);
+        }
 
-        // Inv. Slot
-        invSlotShader.use();
-        for (int i = 0; i < 9; i++) {
-            if (i == app.player.currentInventorySlot)
-                continue;
+        glEnable(GL_DEPTH_TEST);
 
-            glm::vec3 slotColor(0.75f, 0.75f, 0.75f);
-            invSlotShader.setVec3("objectColor", slotColor);
-            glBindVertexArray(app.invSlotVAOs[i]);
-            glLineWidth(3.0f);
-            glDrawArrays(GL_LINES, 0, 8);
+        if (app.showStats) {
+            int framebufferWidth, framebufferHeight;
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            statsOverlay.render(framebufferWidth, framebufferHeight);
         }
 
-        // Selected Slot
-        glm::vec3 slotColor(1.0f, 1.0f, 1.0f);
-        invSlotShader.setVec3("objectColor", slotColor);
-        glBindVertexArray(app.invSlotVAOs[app.player.currentInventorySlot]);
-        glLineWidth(5.0f);
-        glDrawArrays(GL_LINES, 0, 8);
+        // CPU cost of the frame up to the swap, which is where a headless run would wait on the GPU
+        float cpuFrameMs = static_cast<float>((glfwGetTime() - time) * 1000.0);
+        int frameDrawCalls = Stats::drawCalls.load();
+        int64_t frameUploadedBytes = Stats::bytesUploaded.load();
 
+        cpuFrameTimes.push_back(cpuFrameMs);
+        totalDrawCalls += frameDrawCalls;
+        totalUploadedBytes += frameUploadedBytes;
 
-        glBindVertexArray(0);
-        // -------------------------
+        if (!options.dumpFramesPrefix.empty() && frameNumber % options.dumpInterval == 0) {
+            dumpFrame(options.dumpFramesPrefix, frameNumber);
+        }
 
-        // UI. Slot
-        uiSlotShader.use();
-        for (int i = 0; i < 6; i++) {
-            glBindVertexArray(app.uiSlotVAOs[i]);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        {
+            PROFILE_ZONE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
         }
-        // ----------------------------
+        if (frameNumber == 0) {
+            std::cout << "First frame after " << glfwGetTime() * 1000.0 << " ms" << std::endl;
+        }
+        glfwPollEvents();
 
-        glEnable(GL_DEPTH_TEST);
+        Stats::endFrame(realDeltaTime);
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        if (timingLog.is_open()) {
+            timingLog << frameNumber << "," << input.deltaTime * 1000.0f << "," << cpuFrameMs << "," << frameDrawCalls << "," << frameUploadedBytes;
+            for (int pass = 0; pass < GpuProfiler::PASS_COUNT; ++pass) {
+                timingLog << "," << GpuProfiler::getPassTime(static_cast<GpuProfiler::Pass>(pass));
+            }
+            timingLog << "\n";
+        }
+        ++frameNumber;
+
+        if (options.frameLimit > 0 && frameNumber >= options.frameLimit) {
+            glfwSetWindowShouldClose(window, true);
+        }
+    }
+
+    if (Profiler::isEnabled()) {
+        Profiler::dumpChromeTrace("profile_trace.json");
     }
 
-    glDeleteVertexArrays(1, &crossVAO);
-    glDeleteBuffers(1, &crossVBO);
+    if (!options.worldPath.empty()) {
+        WorldSave::save(options.worldPath);
+    }
+
+    if ((app.input.isReplaying() || options.headless) && !cpuFrameTimes.empty()) {
+        std::sort(cpuFrameTimes.begin(), cpuFrameTimes.end());
+        auto percentile = [&cpuFrameTimes](float p) {
+            return cpuFrameTimes[std::min(cpuFrameTimes.size() - 1, static_cast<size_t>(p / 100.0f * cpuFrameTimes.size()))];
+        };
+
+        std::cout << "Ran " << frameNumber << " frames, CPU frame ms p50 " << percentile(50.0f)
+            << " p95 " << percentile(95.0f) << " p99 " << percentile(99.0f)
+            << ", draw calls per frame " << static_cast<double>(totalDrawCalls) / cpuFrameTimes.size()
+            << ", uploaded " << totalUploadedBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+    }
+
+    GpuProfiler::shutdown();
 
     glfwTerminate();
     return 0;
@@ -256,152 +470,341 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
+// Window events are only collected here, processInput applies them with the frame's input
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     AppState* app = static_cast<AppState*>(glfwGetWindowUserPointer(window));
-    if (!app) return;
-
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        if (currentRayResult.hit) {
-            int chunkX = currentRayResult.blockPos.x / CHUNK_SIZE_X;
-            int chunkZ = currentRayResult.blockPos.z / CHUNK_SIZE_Z;
-            if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) return;
-
-            Chunk& chunk = chunks[chunkX][chunkZ];
-            glm::ivec3 localPos = currentRayResult.blockPos - glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
+    if (app) app->input.onMouseButton(button, action);
+}
 
-            if (localPos.x < 0 || localPos.y < 0 || localPos.z < 0 ||
-                localPos.x >= CHUNK_SIZE_X || localPos.y >= CHUNK_SIZE_Y || localPos.z >= CHUNK_SIZE_Z) return;
+void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos) {
+    AppState* app = static_cast<AppState*>(glfwGetWindowUserPointer(window));
+    if (app) app->input.onCursor(xpos, ypos);
+}
 
-            chunk.removeBlock(localPos.x, localPos.y, localPos.z);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+    AppState* app = static_cast<AppState*>(glfwGetWindowUserPointer(window));
+    if (app) app->input.onScroll(yoffset);
+}
 
-            int neighborX = -1;
-            if (localPos.x == 0) {
-                neighborX = chunkX - 1;
-            } else  if (localPos.x == CHUNK_SIZE_X - 1) {
-                neighborX = chunkX + 1;
-            }
-            if (neighborX >= 0 && neighborX < WORLD_SIZE_X) {
-                Chunk& neighborChunk = chunks[neighborX][chunkZ];
-                neighborChunk.regenMesh();
-            }
+bool parseLaunchOptions(int argc, char** argv, LaunchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
 
-            int neighborZ = -1;
-            if (localPos.z == 0) {
-                neighborZ = chunkZ - 1;
-            } else if (localPos.z == CHUNK_SIZE_Z - 1) {
-                neighborZ = chunkZ + 1;
-            }
-            if (neighborZ >= 0 && neighborZ < WORLD_SIZE_Z) {
-                Chunk& neighborChunk = chunks[chunkX][neighborZ];
-                neighborChunk.regenMesh();
+        if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        }
+        else if (arg == "--timing-log" && hasValue) {
+            options.timingLogPath = argv[++i];
+        }
+        else if (arg == "--headless") {
+            options.headless = true;
+        }
+        else if (arg == "--profile") {
+            options.profile = true;
+        }
+        else if (arg == "--camera-path" && hasValue) {
+            options.cameraPathFile = argv[++i];
+        }
+        else if (arg == "--frames" && hasValue) {
+            options.frameLimit = std::atoi(argv[++i]);
+        }
+        else if (arg == "--spawn-entities" && hasValue) {
+            options.spawnEntities = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--dump-frames" && hasValue) {
+            options.dumpFramesPrefix = argv[++i];
+        }
+        else if (arg == "--dump-interval" && hasValue) {
+            options.dumpInterval = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--world" && hasValue) {
+            options.worldPath = argv[++i];
+        }
+        else if (arg == "--seed" && hasValue) {
+            options.worldSeed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--chunk-benchmark" && hasValue) {
+            options.chunkBenchmarkRounds = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--fixed-timestep" && hasValue) {
+            float rate = static_cast<float>(std::atof(argv[++i]));
+            if (rate <= 0.0f) {
+                std::cout << "ERROR::OPTIONS::INVALID_TIMESTEP: " << argv[i] << std::endl;
+                return false;
             }
+            options.fixedDeltaTime = 1.0f / rate;
+        }
+        else {
+            std::cout << "Usage: " << argv[0] << " [--record file] [--replay file] [--timing-log file.csv] [--fixed-timestep hz]\n"
+                << "    [--headless] [--camera-path file] [--frames n] [--dump-frames prefix] [--dump-interval n] [--spawn-entities n]\n"
+                << "    [--world file] [--seed n] [--chunk-benchmark rounds] [--profile]" << std::endl;
+            return false;
         }
     }
 
-    if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
-        if (currentRayResult.hit) {
-            glm::ivec3 blockPos = currentRayResult.blockPos + currentRayResult.faceNormal;
-            if (!app->cam.blockPlaceCheck(blockPos)) return;
+    // Benchmark runs are only useful for comparisons with their timings
+    bool benchmarkRun = !options.replayPath.empty() || options.headless;
+    if (benchmarkRun && options.timingLogPath.empty()) {
+        options.timingLogPath = "frame_times.csv";
+    }
+    // Headless frames take however long software rendering needs, a fixed step keeps the path the same
+    if (options.headless && options.fixedDeltaTime <= 0.0f) {
+        options.fixedDeltaTime = 1.0f / 60.0f;
+    }
+    return true;
+}
 
-            int chunkX = blockPos.x / CHUNK_SIZE_X;
-            int chunkZ = blockPos.z / CHUNK_SIZE_Z;
-            if (chunkX < 0 || chunkX >= WORLD_SIZE_X || chunkZ < 0 || chunkZ >= WORLD_SIZE_Z) return;
+// Only built and run on Windows so far, the project has no Linux build yet
+GLFWwindow* createHeadlessWindow() {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-            Chunk& chunk = chunks[chunkX][chunkZ];
-            glm::ivec3 localPos = blockPos - glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z);
+    // EGL covers real drivers, OSMesa falls back to software rendering through llvmpipe
+    const int contextApis[] = { GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API };
+    for (int contextApi : contextApis) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextApi);
 
-            if (localPos.x < 0 || localPos.y < 0 || localPos.z < 0 ||
-                localPos.x >= CHUNK_SIZE_X || localPos.y >= CHUNK_SIZE_Y || localPos.z >= CHUNK_SIZE_Z) return;
-            chunk.Add(localPos.x, localPos.y, localPos.z, app->player.heldBlock, true);
+        GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Minecraft Clone", NULL, NULL);
+        if (window) return window;
+    }
 
-            int neighborX = -1;
-            if (localPos.x == 0) {
-                neighborX = chunkX - 1;
-            }
-            else  if (localPos.x == CHUNK_SIZE_X - 1) {
-                neighborX = chunkX + 1;
-            }
-            if (neighborX >= 0 && neighborX < WORLD_SIZE_X) {
-                Chunk& neighborChunk = chunks[neighborX][chunkZ];
-                neighborChunk.regenMesh();
-            }
+    std::cout << "ERROR::HEADLESS::NO_OFFSCREEN_CONTEXT" << std::endl;
+    return NULL;
+}
 
-            int neighborZ = -1;
-            if (localPos.z == 0) {
-                neighborZ = chunkZ - 1;
-            }
-            else if (localPos.z == CHUNK_SIZE_Z - 1) {
-                neighborZ = chunkZ + 1;
-            }
-            if (neighborZ >= 0 && neighborZ < WORLD_SIZE_Z) {
-                Chunk& neighborChunk = chunks[chunkX][neighborZ];
-                neighborChunk.regenMesh();
-            }
+void dumpFrame(const std::string& prefix, int frameNumber) {
+    PROFILE_ZONE("dumpFrame");
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    int width = viewport[2];
+    int height = viewport[3];
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%05d.png", frameNumber);
+    PngWriter::writeRgb(prefix + suffix, width, height, pixels.data(), true);
+}
+
+// Spreads items and a few mobs over the world, for entity stress tests
+void scatterEntities(EntityWorld& entities, int count) {
+    uint32_t state = 12345u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0f;
+    };
+
+    const float worldX = static_cast<float>(WORLD_SIZE_X * CHUNK_SIZE_X);
+    const float worldZ = static_cast<float>(WORLD_SIZE_Z * CHUNK_SIZE_Z);
+    for (int i = 0; i < count; ++i) {
+        float x = next() * (worldX - 1.0f);
+        float z = next() * (worldZ - 1.0f);
+        glm::vec3 position(x, getWorldHeightAt(x, z, Heightmap::MOTION_BLOCKING) + 2.0f, z);
+
+        if (i % 10 == 0) {
+            entities.spawn(EntityType::MOB, position, glm::vec3(0.0f));
+        }
+        else {
+            UVHelper::BlockType block = static_cast<UVHelper::BlockType>(1 + i % 6);
+            entities.spawn(EntityType::ITEM, position, glm::vec3(0.0f), block);
+        }
+    }
+}
+
+void collectNearbyItems(AppState& app) {
+    // Items dropped with Q start inside the pickup radius, they need time to fly clear first
+    const float pickupDelay = 0.5f;
+
+    // Camera sits at eye height, items are picked up around the player's feet
+    glm::vec3 feet = app.cam.getCamPos() - glm::vec3(0.0f, 1.5f, 0.0f);
+
+    std::vector<EntityId> nearby;
+    app.entities.queryRadius(feet, 1.5f, nearby);
+    for (EntityId id : nearby) {
+        if (app.entities.getType(id) == EntityType::ITEM && app.entities.getAge(id) >= pickupDelay) {
+            app.entities.despawn(id);
         }
     }
 }
 
-void processInput(AppState& app, GLFWwindow* window) {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+void handleClick(AppState& app, int button) {
+    if (!currentRayResult.hit) return;
+
+    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        glm::ivec3 blockPos = currentRayResult.blockPos;
+        setBlock(blockPos.x, blockPos.y, blockPos.z, UVHelper::BlockType::AIR);
+    }
+
+    if (button == GLFW_MOUSE_BUTTON_RIGHT) {
+        glm::ivec3 blockPos = currentRayResult.blockPos + currentRayResult.faceNormal;
+        if (!app.cam.blockPlaceCheck(blockPos)) return;
+
+        setBlock(blockPos.x, blockPos.y, blockPos.z, app.player.heldBlock);
+    }
+}
+
+void handleWorldEdit(AppState& app, const InputFrame& input) {
+    bool fillPressed = input.isKeyDown(GLFW_KEY_G);
+    bool replacePressed = input.isKeyDown(GLFW_KEY_R);
+    bool copyPressed = input.isKeyDown(GLFW_KEY_C);
+    bool pastePressed = input.isKeyDown(GLFW_KEY_V);
+
+    bool fill = fillPressed && !app.fillPressedLastFrame;
+    bool replace = replacePressed && !app.replacePressedLastFrame;
+    bool copy = copyPressed && !app.copyPressedLastFrame;
+    bool paste = pastePressed && !app.pastePressedLastFrame;
+
+    app.fillPressedLastFrame = fillPressed;
+    app.replacePressedLastFrame = replacePressed;
+    app.copyPressedLastFrame = copyPressed;
+    app.pastePressedLastFrame = pastePressed;
+
+    bool hasSelection = app.selectionCornerSet[0] && app.selectionCornerSet[1];
+    if ((fill || replace || copy) && !hasSelection) {
+        std::cout << "Mark both selection corners first" << std::endl;
+        return;
+    }
+
+    const glm::ivec3& cornerA = app.selectionCorners[0];
+    const glm::ivec3& cornerB = app.selectionCorners[1];
+
+    if (fill) {
+        WorldEdit::fill(cornerA, cornerB, app.player.heldBlock);
+    }
+
+    if (replace && currentRayResult.hit) {
+        glm::ivec3 target = currentRayResult.blockPos;
+        UVHelper::BlockType from = getWorldBlock(target.x, target.y, target.z);
+        int replaced = WorldEdit::replace(cornerA, cornerB, from, app.player.heldBlock);
+        std::cout << "Replaced " << replaced << " blocks" << std::endl;
+    }
+
+    if (copy) {
+        app.clipboard = WorldEdit::copy(cornerA, cornerB);
+        std::cout << "Copied " << app.clipboard.size.x << "x" << app.clipboard.size.y << "x" << app.clipboard.size.z << " blocks" << std::endl;
+    }
+
+    // The clipboard's lowest corner goes where a block placed on the targeted face would
+    if (paste && currentRayResult.hit && !app.clipboard.blocks.empty()) {
+        WorldEdit::paste(app.clipboard, currentRayResult.blockPos + currentRayResult.faceNormal, true);
+    }
+}
+
+void processInput(AppState& app, GLFWwindow* window, const InputFrame& input) {
+    PROFILE_ZONE("processInput");
+
+    if (input.cursorMoved) app.cam.processMouse(input.cursorX, input.cursorY);
+    if (input.scroll != 0.0) app.cam.processScroll(input.scroll);
+    // With alt held a click marks a selection corner instead of editing the block
+    bool selecting = input.isKeyDown(GLFW_KEY_LEFT_ALT);
+    for (int corner = 0; corner < 2; ++corner) {
+        bool clicked = corner == 0 ? input.leftClick : input.rightClick;
+        if (!clicked) continue;
+
+        if (!selecting) {
+            handleClick(app, corner == 0 ? GLFW_MOUSE_BUTTON_LEFT : GLFW_MOUSE_BUTTON_RIGHT);
+        }
+        else if (currentRayResult.hit) {
+            glm::ivec3 blockPos = currentRayResult.blockPos;
+            app.selectionCorners[corner] = blockPos;
+            app.selectionCornerSet[corner] = true;
+            std::cout << "Selection corner " << corner + 1 << " at " << blockPos.x << ", " << blockPos.y << ", " << blockPos.z << std::endl;
+        }
+    }
+
+    if (input.isKeyDown(GLFW_KEY_ESCAPE))
         glfwSetWindowShouldClose(window, true);
 
-    if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
+    bool profileTogglePressed = input.isKeyDown(GLFW_KEY_F8);
+    if (profileTogglePressed && !app.profileTogglePressedLastFrame) {
+        Profiler::setEnabled(!Profiler::isEnabled());
+        std::cout << (Profiler::isEnabled() ? "Profiler recording" : "Profiler stopped") << std::endl;
+    }
+    app.profileTogglePressedLastFrame = profileTogglePressed;
+
+    bool profileDumpPressed = input.isKeyDown(GLFW_KEY_F9);
+    if (profileDumpPressed && !app.profileDumpPressedLastFrame) {
+        Profiler::dumpChromeTrace("profile_trace.json");
+    }
+    app.profileDumpPressedLastFrame = profileDumpPressed;
+
+    // Q drops the held block as an item, F fires a projectile
+    glm::vec3 eye = app.cam.getCamPos();
+    glm::vec3 look = app.cam.getCamTarget();
+
+    bool dropPressed = input.isKeyDown(GLFW_KEY_Q);
+    if (dropPressed && !app.dropPressedLastFrame && app.player.heldBlock != UVHelper::BlockType::AIR) {
+        app.entities.spawn(EntityType::ITEM, eye + look * 0.5f - glm::vec3(0.0f, 0.3f, 0.0f),
+            look * 6.0f + glm::vec3(0.0f, 2.0f, 0.0f), app.player.heldBlock);
+    }
+    app.dropPressedLastFrame = dropPressed;
+
+    bool firePressed = input.isKeyDown(GLFW_KEY_F);
+    if (firePressed && !app.firePressedLastFrame) {
+        app.entities.spawn(EntityType::PROJECTILE, eye + look * 0.5f, look * 30.0f);
+    }
+    app.firePressedLastFrame = firePressed;
+
+    handleWorldEdit(app, input);
+
+    bool statsPressed = input.isKeyDown(GLFW_KEY_F3);
+    if (statsPressed && !app.statsPressedLastFrame) {
+        app.showStats = !app.showStats;
+    }
+    app.statsPressedLastFrame = statsPressed;
+
+    if (input.isKeyDown(GLFW_KEY_1)) {
         app.player.heldBlock = UVHelper::BlockType::GRASS;
         app.player.currentInventorySlot = 0;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_2)) {
         app.player.heldBlock = UVHelper::BlockType::DIRT;
         app.player.currentInventorySlot = 1;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_3)) {
         app.player.heldBlock = UVHelper::BlockType::STONE;
         app.player.currentInventorySlot = 2;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_4)) {
         app.player.heldBlock = UVHelper::BlockType::OAKLOG;
         app.player.currentInventorySlot = 3;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_5) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_5)) {
         app.player.heldBlock = UVHelper::BlockType::OAKLEAVES;
         app.player.currentInventorySlot = 4;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_6) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_6)) {
         app.player.heldBlock = UVHelper::BlockType::WATER;
         app.player.currentInventorySlot = 5;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_7) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_7)) {
         app.player.heldBlock = UVHelper::BlockType::AIR;
         app.player.currentInventorySlot = 6;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_8) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_8)) {
         app.player.heldBlock = UVHelper::BlockType::AIR;
         app.player.currentInventorySlot = 7;
-        updateSlots(app);
     }
-    else if (glfwGetKey(window, GLFW_KEY_9) == GLFW_PRESS) {
+    else if (input.isKeyDown(GLFW_KEY_9)) {
         app.player.heldBlock = UVHelper::BlockType::AIR;
         app.player.currentInventorySlot = 8;
-        updateSlots(app);
     }
 
-    bool sprinting = false;
-    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
-        sprinting = true;
-    app.cam.updateFOV(sprinting, app.deltaTime);
-    app.cam.processCameraInput(window, app.deltaTime, sprinting);
+    app.sprinting = input.isKeyDown(GLFW_KEY_LEFT_CONTROL);
+    app.cam.updateFOV(app.sprinting, app.deltaTime);
 
     // Double click space check
-    bool spacePressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    bool spacePressed = input.isKeyDown(GLFW_KEY_SPACE);
 
     if (spacePressed && !app.spacePressedLastFrame) {
-        float currentTime = static_cast<float>(glfwGetTime());
+        float currentTime = app.simulationTime;
 
         if (app.firstSpaceTap && (currentTime - app.lastSpaceTapTime) <= 0.3f) {
             bool isStatePhysical = !app.player.physicalState;
@@ -419,144 +822,6 @@ void processInput(AppState& app, GLFWwindow* window) {
 
 }
 
-unsigned int loadTexture(const char* path) {
-    unsigned int texID;
-
-    glGenTextures(1, &texID);
-
-    int width, height, nrChannels;
-
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-    if (data) {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        glBindTexture(GL_TEXTURE_2D, texID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    }
-    else {
-        std::cout << "FAILED TO LOAD TEXTURE" << std::endl;
-    }
-
-    stbi_image_free(data);
-    return texID;
-}
-
-void crosshairSetUp(unsigned int& VAO, unsigned int& VBO) {
-    float crossSizeVertical = 1920.0 / 100000.0;
-    float crossSizeHorizontal = 1080.0 / 100000.0;
-
-    float crosshairVertices[] = {
-        -crossSizeHorizontal, 0.0f,
-         crossSizeHorizontal, 0.0f,
-         0.0f, -crossSizeVertical,
-         0.0f,  crossSizeVertical
-    };
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(crosshairVertices), crosshairVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-}
-
-void updateSlots(AppState& app) {
-    for (int i = 0; i < 9; ++i) {
-        unsigned int invSlotVAO, invSlotVBO;
-        invSlotSetUp(invSlotVAO, invSlotVBO, i, i == app.player.currentInventorySlot);
-        app.invSlotVAOs[i] = invSlotVAO;
-        app.invSlotVBOs[i] = invSlotVBO;
-    }
-}
-void invSlotSetUp(unsigned int& VAO, unsigned int& VBO, int index, bool selected) {
-    const float leftX = -0.3f;
-    const float rightX = 0.3f;
-
-    const float bottomY = -1.0f;
-    const float topY = -0.88f;
-
-    float leftOffset{};
-    float rightOffset{};
-    float verticalOffset{};
-    if (selected) {
-        leftOffset = 0.0025f;
-        rightOffset = 0.0025f;
-        verticalOffset = 0.005f;
-    }
-    else {
-        leftOffset = index == 0 ? 0.0015f : 0.0f;
-        rightOffset = index == 8 ? 0.0015f : 0.0f;
-        verticalOffset = 0.003f;
-    }
-    const float invSlotXJumps = 0.6f / 9;
-
-    float invSlotVertices[] = {
-        leftX + (invSlotXJumps * index), topY,
-        leftX + (invSlotXJumps * index), bottomY,
-
-        leftX + (invSlotXJumps * (index+1)), topY,
-        leftX + (invSlotXJumps * (index+1)), bottomY,
-
-        leftX + (invSlotXJumps * index), topY - verticalOffset,
-        leftX + (invSlotXJumps * (index+1)), topY - verticalOffset,
-
-        leftX + (invSlotXJumps * index), bottomY + verticalOffset,
-        leftX + (invSlotXJumps * (index + 1)), bottomY + verticalOffset
-    };
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(invSlotVertices), invSlotVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-}
-
-void uiSlotSetUp(unsigned int& VAO, unsigned int& VBO, int index) {
-    const float leftX = -0.29f;
-    const float rightX = 0.29f;
-
-    const float bottomY = -0.98f;
-    const float topY = -0.90f;
-    const float uiSlotXJumps = 0.6f / 9;
-    const float x0 = leftX + (uiSlotXJumps * index);
-    const float x1 = leftX + (uiSlotXJumps * (index + 1)) - 0.02f;
-
-    UVHelper::BlockUV uvSet = UVHelper::blockTextures[index+1];
-    UVHelper::UVCoords uv = UVHelper::getUVCoords(uvSet.side, 3, 16, 48);
-
-    float uiSlotVertices[] = {
-        x0, topY,       uv.uMin, uv.vMin,
-        x0, bottomY,    uv.uMin, uv.vMax,
-        x1, topY,       uv.uMax, uv.vMin,
-        x1, bottomY,    uv.uMax, uv.vMax
-    };
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(uiSlotVertices), uiSlotVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-}
-
 void highlightBlockSetUp(unsigned int& VAO, unsigned int& VBO) {
     constexpr float vertices[] = {
         // left face
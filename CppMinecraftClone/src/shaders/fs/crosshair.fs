@@ -1,6 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-void main () {
-	FragColor = vec4(1.0);
-}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#version 330 core
+
+uniform vec3 lightColor;
+uniform vec3 lightDir;
+
+in vec3 Normal;
+in vec3 Color;
+
+out vec4 FragColor;
+
+void main()
+{
+    float ambientStrength = 0.35;
+    vec3 ambient = ambientStrength * lightColor;
+
+    float diff = max(dot(normalize(Normal), -lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+
+    FragColor = vec4((ambient + diffuse) * Color, 1.0);
+}
@@ -1,6 +1,6 @@
 #version 330 core
 
-uniform sampler2D textureVal;
+uniform sampler2DArray textureVal;
 
 uniform vec3 objectColor;
 uniform vec3 lightColor;
@@ -9,6 +9,7 @@ uniform vec3 lightDir;
 uniform float opacity;
 
 in vec2 TexCoord;
+flat in float Layer;
 
 in vec3 FragPos;
 in vec3 Normal;
@@ -24,7 +25,7 @@ void main()
     float diff = max(dot(norm, -lightDir), 0.0);
     vec3 diffuse = diff * lightColor;
 
-    vec4 texColor = texture(textureVal, TexCoord);
+    vec4 texColor = texture(textureVal, vec3(TexCoord, Layer));
     if (texColor.a < 0.1)
         discard;
 
@@ -0,0 +1,35 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 TexCoord;
+in vec2 Pos;
+flat in vec4 Rect;
+flat in vec4 Color;
+flat in vec2 Params;
+
+uniform sampler2DArray textureVal;
+// Size of one screen pixel in NDC
+uniform vec2 pixelSize;
+
+const float KIND_TEXTURED = 1.0;
+const float KIND_OUTLINE = 2.0;
+
+void main() {
+    if (Params.x == KIND_TEXTURED) {
+        FragColor = texture(textureVal, TexCoord) * Color;
+        return;
+    }
+
+    if (Params.x == KIND_OUTLINE) {
+        // The selected slot gets a thicker, brighter frame
+        bool selected = Params.y > 0.5;
+        vec2 border = pixelSize * (selected ? 5.0 : 3.0);
+        if (all(greaterThan(Pos, Rect.xy + border)) && all(lessThan(Pos, Rect.zw - border)))
+            discard;
+
+        FragColor = vec4(vec3(selected ? 1.0 : 0.75), 1.0);
+        return;
+    }
+
+    FragColor = Color;
+}
@@ -1,8 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-uniform vec3 objectColor;
-
-void main () {
-	FragColor = vec4(objectColor, 1.0);
-}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+in vec4 Color;
+
+uniform sampler2D fontTexture;
+
+void main() {
+    FragColor = vec4(Color.rgb, Color.a * texture(fontTexture, TexCoord).r);
+}
@@ -1,9 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-
-uniform sampler2D textureVal;
-
-void main() {
-    FragColor = texture(textureVal, TexCoord);
-}
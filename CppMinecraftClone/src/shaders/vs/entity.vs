@@ -0,0 +1,22 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// Per instance: feet position and half width, then color and height
+layout (location = 2) in vec4 aPlacement;
+layout (location = 3) in vec4 aColorHeight;
+
+out vec3 Normal;
+out vec3 Color;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    vec3 size = vec3(aPlacement.w * 2.0, aColorHeight.a, aPlacement.w * 2.0);
+    vec3 worldPos = aPlacement.xyz + (aPos + vec3(0.0, 0.5, 0.0)) * size;
+
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+    Normal = aNormal;
+    Color = aColorHeight.rgb;
+}
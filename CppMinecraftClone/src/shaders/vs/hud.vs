@@ -0,0 +1,24 @@
+#version 330 core
+// Per instance, the quad's corners come from gl_VertexID
+layout (location = 0) in vec4 aRect;
+layout (location = 1) in vec4 aColor;
+// Kind, selected, texture array layer
+layout (location = 2) in vec4 aParams;
+
+out vec3 TexCoord;
+out vec2 Pos;
+flat out vec4 Rect;
+flat out vec4 Color;
+flat out vec2 Params;
+
+void main () {
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+	Pos = mix(aRect.xy, aRect.zw, corner);
+	gl_Position = vec4(Pos, 0.0, 1.0);
+
+	// v runs top to bottom in a tile
+	TexCoord = vec3(corner.x, 1.0 - corner.y, aParams.z);
+	Rect = aRect;
+	Color = aColor;
+	Params = aParams.xy;
+}
@@ -1,9 +1,11 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoord;
+layout (location = 2) in float aLayer;
 
 out vec2 TexCoord;
+// Not interpolated, far terrain vertices of one triangle can sit in different biomes
+flat out float Layer;
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -12,10 +14,23 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// Texture coordinates in blocks, projected along the face's axis. Vertices sit on block
+// edges, so a face spanning several blocks repeats its tile once per block
+vec2 faceUV(vec3 pos, vec3 normal)
+{
+    vec3 n = abs(normal);
+    if (n.y > max(n.x, n.z))
+        return normal.y > 0.0 ? vec2(pos.x + 0.5, pos.z + 0.5) : vec2(pos.x + 0.5, 0.5 - pos.z);
+    if (n.x >= n.z)
+        return vec2(0.5 - pos.z, 0.5 - pos.y);
+    return vec2(pos.x + 0.5, 0.5 - pos.y);
+}
+
 void main()
 {
     gl_Position = projection * view * model * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
+    TexCoord = faceUV(aPos, aNormal);
+    Layer = aLayer;
 
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;